@@ -4,13 +4,37 @@
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "Math/UnrealMathUtility.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Hash/CityHash.h"
+#include "Misc/Compression.h"
+#include "FTerrainNoise.h"
+#include "UBuildSystem.h"
+
+// Tek block delta RPC'sinin taşıdığı en fazla değişiklik (4 byte/değişiklik) - büyük delta'lar bölünür
+static constexpr int32 MaxBlockDeltaChangesPerRPC = 4096;
+// Client: journal/üretim beklerken tutulan en fazla delta
+static constexpr int32 MaxDeferredBlockDeltas = 8192;
+// Server: chunk başına blok blok tutulan en fazla edit - fazlası chunk'ın tamamı olarak gönderilir
+static constexpr int32 MaxTrackedEditsPerChunk = 2048;
 
 ARandomMapGenerator::ARandomMapGenerator()
 {
     PrimaryActorTick.bCanEverTick = true;
     bReplicates = true;
     bAlwaysRelevant = true;
+    ReplicatedBlockEdits.Owner = this;
     bIsGeneratingWorld = false;
     bHasGeneratedWorld = false;
     bWorldGenerationComplete = false;
@@ -45,6 +69,8 @@ void ARandomMapGenerator::BeginPlay()
     Super::BeginPlay();
     // Initialize ISMs for each block type (now chunk-based)
     InitializeBlockISMs();
+    // Merged mesh / shared ISM modları için atlas tile'larını cache'le
+    CacheBlockAtlasTiles();
     // Initialize debug system
     InitializeDebugSystem();
 }
@@ -52,6 +78,110 @@ void ARandomMapGenerator::BeginPlay()
 void ARandomMapGenerator::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
+
+    // Dünya üretimi: her frame GenerationBudgetMs kadar ilerle, kalan iş sonraki frame'lere kalır
+    if (bIsGeneratingWorld && GenerationStage != EWorldGenerationStage::None && !bAwaitingChunkBuilds)
+    {
+        AdvanceWorldGeneration();
+    }
+
+    // Bu frame'de istenen chunk build'lerini worker thread'lere gönder
+    if (PendingChunkBuilds.Num() > 0)
+    {
+        FlushChunkBuildRequests();
+    }
+
+    // Streaming modunda üretim bitince oyuncuların etrafındaki chunk'ları yükle / uzaktakileri bırak
+    if (bStreamWorld && bHasGeneratedWorld && !bIsGeneratingWorld)
+    {
+        UpdateWorldStreaming(DeltaTime);
+    }
+
+    // Server: hangi bağlantı hangi chunk'ların edit'lerini alıyor (fast array modunda herkes her şeyi alır)
+    if (HasAuthority() && bChunkRelevancy && !bReplicateBlockEditsAsFastArray && bHasGeneratedWorld)
+    {
+        ChunkRelevancyTimer += DeltaTime;
+        if (ChunkRelevancyTimer >= ChunkRelevancyUpdateInterval)
+        {
+            ChunkRelevancyTimer = 0.f;
+            UpdateChunkSubscriptions();
+        }
+    }
+
+    // Bu tick'te değişen bloklar chunk başına tek multicast olarak gider
+    if (PendingBlockDeltas.Num() > 0)
+    {
+        FlushBlockDeltas();
+    }
+
+    // Server: geç katılan client'lara edit journal'ı / client: journal'ı iste (BuildSystem pawn'la birlikte gelir)
+    if (EditJournalStreams.Num() > 0)
+    {
+        PumpEditJournalStreams(DeltaTime);
+    }
+    if (PendingReplicatedBlockEdits.Num() > 0 && bHasGeneratedWorld && !bIsGeneratingWorld && !bAwaitingEditJournal)
+    {
+        ApplyReplicatedBlockEdits();
+    }
+    if (bAwaitingEditJournal)
+    {
+        // Pawn değişince (ölüm/respawn) yoldaki parçalar kaybolur; uzun süre parça gelmezse de akış kayıp sayılır -
+        // server aynı snapshot'ı baştan yeni component üzerinden gönderir
+        UBuildSystem* BuildSystem = GetLocalBuildSystem();
+        const double Now = GetWorld()->GetTimeSeconds();
+        if (BuildSystem && (!bEditJournalRequested || BuildSystem != EditJournalRequester.Get() ||
+            Now - EditJournalActivityTime > FMath::Max(EditJournalTimeout, 1.f)))
+        {
+            if (bEditJournalRequested)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("CLIENT: Edit journal stream lost - requesting it again"));
+            }
+
+            ReceivedEditJournal.Reset();
+            ReceivedEditJournalParts = 0;
+            BuildSystem->ServerRequestEditJournal();
+            bEditJournalRequested = true;
+            EditJournalRequester = BuildSystem;
+            EditJournalActivityTime = Now;
+        }
+    }
+
+    // Hasar durumları daha seyrek ve unreliable gider - kaybolan paketin yerine sonraki vuruş geçer
+    BlockDamageSendTimer += DeltaTime;
+    if (PendingBlockDamageStates.Num() > 0 && BlockDamageSendTimer >= BlockDamageSendInterval)
+    {
+        BlockDamageSendTimer = 0.f;
+        FlushBlockDamageStates();
+    }
+
+    // Server: değişen chunk hash'lerini client'lara yayınla / client: gecikmeli hash kontrolü
+    if (HasAuthority() && bHasGeneratedWorld && !bIsGeneratingWorld && DirtyChunkHashes.Num() > 0)
+    {
+        PublishChunkHashes(false);
+    }
+    if (ChunkHashVerifyTime > 0.0 && GetWorld()->GetTimeSeconds() >= ChunkHashVerifyTime)
+    {
+        VerifyChunkHashes();
+    }
+
+    // Dünya üretimi ilk chunk build'lerinin commit edilmesini bekliyor
+    if (bAwaitingChunkBuilds && NumChunkBuildsInFlight == 0 && PendingChunkBuilds.Num() == 0)
+    {
+        bAwaitingChunkBuilds = false;
+        CompleteGenerationStage();
+        GenerationStage = EWorldGenerationStage::None;
+        OnGenerationProgressUpdated.Broadcast(1.0f);
+        LogGenerationStageTimes();
+
+        if (HasAuthority())
+        {
+            FinishServerWorldGeneration();
+        }
+        else
+        {
+            FinishClientWorldGeneration();
+        }
+    }
 }
 
 void ARandomMapGenerator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -70,6 +200,10 @@ void ARandomMapGenerator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
     DOREPLIFETIME(ARandomMapGenerator, BlockSize);
     DOREPLIFETIME(ARandomMapGenerator, BlockSpacing);
     DOREPLIFETIME(ARandomMapGenerator, SpawnedBaseCore);
+    // Chunk content hashes - clients repair chunks that diverged
+    DOREPLIFETIME(ARandomMapGenerator, ChunkHashes);
+    // Fast array block edits - boşken maliyeti yok
+    DOREPLIFETIME(ARandomMapGenerator, ReplicatedBlockEdits);
     // Only replicate completion flag, not all blocks
     DOREPLIFETIME(ARandomMapGenerator, bWorldGenerationComplete);
 }
@@ -98,92 +232,218 @@ void ARandomMapGenerator::OnRep_WorldGenerationComplete()
 // *** UPDATED: CHUNK-BASED ISM INITIALIZATION ***
 void ARandomMapGenerator::InitializeBlockISMs()
 {
-    // Clear any existing chunk ISM system
+    // Clear any existing chunk ISM system (components go back to the pool)
     for (auto& ChunkPair : ChunkISMSystem)
     {
-        FChunkISMData& ChunkData = ChunkPair.Value;
-        for (auto& ISMPair : ChunkData.ChunkISMs)
-        {
-            if (ISMPair.Value)
-            {
-                ISMPair.Value->DestroyComponent();
-            }
-        }
+        ReleaseChunkISMs(ChunkPair.Key, ChunkPair.Value);
     }
     ChunkISMSystem.Empty();
 
     UE_LOG(LogTemp, Warning, TEXT("Chunk-based ISM system initialized (chunks will be created on-demand)"));
 }
 
-// *** NEW: CHUNK ISM INITIALIZATION ***
+// *** UPDATED: LAZY CHUNK ISM CREATION ***
+// Chunk kaydı boş başlar; bir blok tipinin component'i o tipin ilk instance'ında oluşturulur
+// ve InstanceCounts sıfıra düşünce serbest bırakılır. Çoğu chunk'ta Turret/Trap/Storage vb. hiç yoktur.
 void ARandomMapGenerator::InitializeChunkISMs(const FChunkCoord& ChunkCoord)
 {
-    if (ChunkISMSystem.Contains(ChunkCoord))
+    if (!ChunkISMSystem.Contains(ChunkCoord))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Chunk ISMs already exist for chunk (%d,%d)"), ChunkCoord.X, ChunkCoord.Y);
-        return;
+        ChunkISMSystem.Add(ChunkCoord, FChunkISMData());
     }
+}
+
+UHierarchicalInstancedStaticMeshComponent* ARandomMapGenerator::GetOrCreateChunkISM(const FChunkCoord& ChunkCoord, EBlockType BlockType)
+{
+    if (BlockType == EBlockType::Air)
+        return nullptr;
 
-    FChunkISMData NewChunkData;
+    InitializeChunkISMs(ChunkCoord);
+    FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
 
-    // Her blok tipi için ISM oluştur
-    for (int32 TypeIdx = 1; TypeIdx < static_cast<int32>(EBlockType::MAX); TypeIdx++)
+    // Shared modda tüm küp tipleri tek component'i (Air slotu) paylaşır
+    const EBlockType Slot = GetChunkISMSlot(BlockType);
+    if (UHierarchicalInstancedStaticMeshComponent* ExistingISM = ChunkData.ChunkISMs.FindRef(Slot))
     {
-        EBlockType BlockType = static_cast<EBlockType>(TypeIdx);
-        if (BlockType == EBlockType::Air) continue;
+        return ExistingISM;
+    }
 
-        // ISM component oluştur
-        FString ComponentName = FString::Printf(TEXT("ChunkISM_%d_%d_%s"),
-            ChunkCoord.X, ChunkCoord.Y,
-            *UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT("")));
+    // Önce havuzdan: yeniden kayıt/isimlendirme ve GC yok, sadece instance buffer'ı boş bir component
+    UHierarchicalInstancedStaticMeshComponent* ChunkISM = AcquirePooledChunkISM(ChunkCoord, Slot);
+    if (ChunkISM)
+    {
+        ConfigureChunkISM(ChunkISM, Slot, BlockType);
 
-        UHierarchicalInstancedStaticMeshComponent* ChunkISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, FName(*ComponentName));
-        ChunkISM->SetupAttachment(RootComponent);
-        ChunkISM->RegisterComponent();
+        ChunkData.ChunkISMs.Add(Slot, ChunkISM);
+        ChunkData.InstanceCounts.Add(Slot, 0);
+        return ChunkISM;
+    }
 
-        // ISM ayarları
-        if (BlockType == EBlockType::InvisibleWall)
+    // ISM component oluştur (serbest bırakılıp yeniden oluşturulabildiği için isim benzersiz olmalı)
+    FString ComponentName = FString::Printf(TEXT("ChunkISM_%d_%d_%s"),
+        ChunkCoord.X, ChunkCoord.Y,
+        Slot == EBlockType::Air ? TEXT("Shared") : *UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT("")));
+    FName UniqueName = MakeUniqueObjectName(this, UHierarchicalInstancedStaticMeshComponent::StaticClass(), FName(*ComponentName));
+
+    ChunkISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, UniqueName);
+    ChunkISM->SetupAttachment(RootComponent);
+    ChunkISM->RegisterComponent();
+
+    ConfigureChunkISM(ChunkISM, Slot, BlockType);
+
+    // Chunk data'ya ekle
+    ChunkData.ChunkISMs.Add(Slot, ChunkISM);
+    ChunkData.InstanceCounts.Add(Slot, 0);
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Created chunk ISM for (%d,%d) type %s"),
+        ChunkCoord.X, ChunkCoord.Y, *UEnum::GetValueAsString(BlockType));
+
+    return ChunkISM;
+}
+
+void ARandomMapGenerator::ConfigureChunkISM(UHierarchicalInstancedStaticMeshComponent* ChunkISM, EBlockType Slot, EBlockType BlockType)
+{
+    // ISM ayarları
+    if (BlockType == EBlockType::InvisibleWall)
+    {
+        ChunkISM->SetCollisionProfileName(TEXT("BlockAll"));
+        ChunkISM->SetVisibility(false);
+        ChunkISM->SetHiddenInGame(true);
+        ChunkISM->SetGenerateOverlapEvents(true);
+        ChunkISM->SetCanEverAffectNavigation(true);
+        ChunkISM->bCastDynamicShadow = false;
+    }
+    else
+    {
+        ChunkISM->SetCollisionProfileName(TEXT("BlockAll"));
+        ChunkISM->SetGenerateOverlapEvents(true);
+        ChunkISM->SetCanEverAffectNavigation(true);
+        ChunkISM->bCastDynamicShadow = true;
+    }
+
+    // Mesh ve material ayarla
+    if (Slot == EBlockType::Air)
+    {
+        // Tip başına mesh/material yerine tek küp mesh + texture array material; tip ve hasar PerInstanceCustomData'da
+        ChunkISM->SetStaticMesh(SharedCubeMesh);
+        if (!SharedCubeMesh && BlockDataTable)
         {
-            ChunkISM->SetCollisionProfileName(TEXT("BlockAll"));
-            ChunkISM->SetVisibility(false);
-            ChunkISM->SetHiddenInGame(true);
-            ChunkISM->SetGenerateOverlapEvents(true);
-            ChunkISM->SetCanEverAffectNavigation(true);
-            ChunkISM->bCastDynamicShadow = false;
+            FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
+            if (FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT("")))
+            {
+                ChunkISM->SetStaticMesh(BlockDataRow->BlockMesh);
+            }
         }
-        else
+
+        if (!SharedCubeMaterialInstance)
         {
-            ChunkISM->SetCollisionProfileName(TEXT("BlockAll"));
-            ChunkISM->SetGenerateOverlapEvents(true);
-            ChunkISM->SetCanEverAffectNavigation(true);
-            ChunkISM->bCastDynamicShadow = true;
+            InitializeSharedCubeMaterial();
+        }
+        if (SharedCubeMaterialInstance)
+        {
+            ChunkISM->SetMaterial(0, SharedCubeMaterialInstance);
         }
 
-        // Mesh ve material ayarla
-        if (BlockDataTable)
+        ChunkISM->SetNumCustomDataFloats(GetSharedCustomDataFloats());
+    }
+    else if (BlockDataTable)
+    {
+        FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
+        FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
+        if (BlockDataRow)
         {
-            FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
-            FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
-            if (BlockDataRow)
+            ChunkISM->SetStaticMesh(BlockDataRow->BlockMesh);
+            if (BlockDataRow->BlockMaterial)
             {
-                ChunkISM->SetStaticMesh(BlockDataRow->BlockMesh);
-                if (BlockDataRow->BlockMaterial)
-                {
-                    ChunkISM->SetMaterial(0, BlockDataRow->BlockMaterial);
-                }
+                ChunkISM->SetMaterial(0, BlockDataRow->BlockMaterial);
             }
         }
+    }
+}
+
+void ARandomMapGenerator::ReleaseChunkISMIfEmpty(const FChunkCoord& ChunkCoord, FChunkISMData& ChunkData, EBlockType BlockType)
+{
+    const int32* InstanceCount = ChunkData.InstanceCounts.Find(BlockType);
+    if (InstanceCount && *InstanceCount > 0)
+        return;
+
+    UHierarchicalInstancedStaticMeshComponent* ChunkISM = nullptr;
+    if (ChunkData.ChunkISMs.RemoveAndCopyValue(BlockType, ChunkISM) && ChunkISM)
+    {
+        ReleaseChunkISMToPool(ChunkCoord, BlockType, ChunkISM);
+    }
+
+    ChunkData.InstanceCounts.Remove(BlockType);
+    ChunkData.InstanceKeys.Remove(BlockType);
+}
+
+// *** NEW: CHUNK ISM POOL ***
+// Yeni seed'de component'ler yok edilip yeniden oluşturulmaz: instance'ları silinip havuza döner,
+// aynı (chunk, slot) için - yoksa aynı slot'un herhangi biri - tekrar kullanılır.
+
+UHierarchicalInstancedStaticMeshComponent* ARandomMapGenerator::AcquirePooledChunkISM(const FChunkCoord& ChunkCoord, EBlockType Slot)
+{
+    UHierarchicalInstancedStaticMeshComponent* ChunkISM = nullptr;
+    if (PooledChunkISMs.RemoveAndCopyValue(FIntVector(ChunkCoord.X, ChunkCoord.Y, static_cast<int32>(Slot)), ChunkISM) && IsValid(ChunkISM))
+    {
+        return ChunkISM;
+    }
+
+    TArray<FIntVector>* SlotKeys = PooledChunkISMKeys.Find(Slot);
+    while (SlotKeys && SlotKeys->Num() > 0)
+    {
+        if (PooledChunkISMs.RemoveAndCopyValue(SlotKeys->Pop(false), ChunkISM) && IsValid(ChunkISM))
+        {
+            return ChunkISM;
+        }
+    }
+
+    return nullptr;
+}
+
+void ARandomMapGenerator::ReleaseChunkISMToPool(const FChunkCoord& ChunkCoord, EBlockType Slot, UHierarchicalInstancedStaticMeshComponent* ChunkISM)
+{
+    if (!IsValid(ChunkISM))
+        return;
+
+    if (PooledChunkISMs.Num() >= MaxPooledChunkISMs)
+    {
+        ChunkISM->DestroyComponent();
+        return;
+    }
 
-        // Chunk data'ya ekle
-        NewChunkData.ChunkISMs.Add(BlockType, ChunkISM);
-        NewChunkData.InstanceCounts.Add(BlockType, 0);
+    // Sadece instance buffer'ı sıfırlanır; component kayıtlı kalır
+    ChunkISM->ClearInstances();
 
-        UE_LOG(LogTemp, VeryVerbose, TEXT("Created chunk ISM for (%d,%d) type %s"),
-            ChunkCoord.X, ChunkCoord.Y, *UEnum::GetValueAsString(BlockType));
+    const FIntVector PoolKey(ChunkCoord.X, ChunkCoord.Y, static_cast<int32>(Slot));
+    UHierarchicalInstancedStaticMeshComponent* Replaced = nullptr;
+    if (PooledChunkISMs.RemoveAndCopyValue(PoolKey, Replaced) && Replaced && Replaced != ChunkISM)
+    {
+        Replaced->DestroyComponent();
+    }
+
+    PooledChunkISMs.Add(PoolKey, ChunkISM);
+
+    // Aynı (chunk, slot) ile geri alınanların anahtarları listede kalır - ara sıra ayıkla
+    TArray<FIntVector>& SlotKeys = PooledChunkISMKeys.FindOrAdd(Slot);
+    SlotKeys.Add(PoolKey);
+    if (SlotKeys.Num() > PooledChunkISMs.Num() * 2 + 64)
+    {
+        SlotKeys.RemoveAll([this](const FIntVector& Key) { return !PooledChunkISMs.Contains(Key); });
+    }
+}
+
+void ARandomMapGenerator::ReleaseChunkISMs(const FChunkCoord& ChunkCoord, FChunkISMData& ChunkData)
+{
+    for (auto& ISMPair : ChunkData.ChunkISMs)
+    {
+        ReleaseChunkISMToPool(ChunkCoord, ISMPair.Key, ISMPair.Value);
     }
 
-    ChunkISMSystem.Add(ChunkCoord, NewChunkData);
-    UE_LOG(LogTemp, Display, TEXT("Chunk ISM system initialized for chunk (%d,%d)"), ChunkCoord.X, ChunkCoord.Y);
+    ChunkData.ChunkISMs.Empty();
+    ChunkData.InstanceCounts.Empty();
+    ChunkData.InstanceKeys.Empty();
+    ChunkData.InstanceIndexMapping.Empty();
 }
 
 UInstancedStaticMeshComponent* ARandomMapGenerator::GetChunkISM(const FChunkCoord& ChunkCoord, EBlockType BlockType)
@@ -252,8 +512,72 @@ void ARandomMapGenerator::SetNewSeed(int32 NewSeed)
 
 void ARandomMapGenerator::ClearGeneratorState()
 {
-    // Clear all existing data structures for clean regeneration
-    BlocksData.Empty();
+    // Worker thread'lerde çalışan chunk build'lerini iptal et (sonuçları zaten bayat sayılacak)
+    for (auto& ChunkPair : ChunksInfo)
+    {
+        if (ChunkPair.Value.BuildCancelToken.IsValid())
+        {
+            *ChunkPair.Value.BuildCancelToken = true;
+        }
+    }
+    PendingChunkBuilds.Empty();
+    bAwaitingChunkBuilds = false;
+
+    // Yarıda kalan time-sliced üretimi bırak
+    GenerationStage = EWorldGenerationStage::None;
+    CompletedGenerationStages = 0;
+    GenerationStageDependencies.Empty();
+    bBaseCoreAreaFlattened = false;
+    bLoadedFromWorldCache = false;
+    bSavedWorldCache = false;
+    NextChunkToGenerate = 0;
+    GenerationStepsDone = 0;
+    GenerationStepsTotal = 0;
+    ChunkGenerationOrder.Empty();
+    PendingFeatureWrites.Empty();
+
+    // Hash doğrulama durumu (server yeni dünya bitene kadar hash yayınlamaz)
+    DirtyChunkHashes.Empty();
+    ChunkResyncBudgets.Empty();
+    PendingBlockDeltas.Empty();
+    PendingBlockDamageStates.Empty();
+    DeferredBlockDeltas.Empty();
+    EditJournalStreams.Empty();
+    CompletedEditJournals.Empty();
+    bAwaitingEditJournal = false;
+    bEditJournalRequested = false;
+    EditJournalRequester.Reset();
+    ReceivedEditJournal.Empty();
+    ReceivedEditJournalParts = 0;
+    // Client: eski dünyanın bekleyen edit'leri - yeni dünyanınkiler üretim sonunda ReplicatedBlockEdits'ten kurulur
+    PendingReplicatedBlockEdits.Empty();
+    SuspectChunkHashes.Empty();
+    RequestedChunkResyncs.Empty();
+    ChunkHashVerifyTime = 0.0;
+    NumChunkResyncs = 0;
+    if (HasAuthority())
+    {
+        ChunkHashes.Empty();
+        ChunkHashIndices.Empty();
+
+        // Yeni dünyada edit yok - client'lar da sıfırdan üretir
+        ChunkSubscribers.Empty();
+        ChunkEditVersions.Empty();
+        ChunkEdits.Empty();
+        SnapshotEditChunks.Empty();
+        ChunkRelevancyTimer = ChunkRelevancyUpdateInterval;
+
+        ReplicatedBlockEdits.Items.Reset();
+        ReplicatedBlockEdits.MarkArrayDirty();
+        ReplicatedBlockEditIndices.Empty();
+    }
+
+    // Streaming durumu
+    StreamingQueue.Empty();
+    StreamUpdateTimer = 0.0f;
+    GeneratedEdgeFeatures = 0;
+
+    // Clear all existing data structures for clean regeneration (block data lives inside ChunksInfo)
     ChunksInfo.Empty();
     BlockDamageData.Empty();
     DestroyedBlocksProcessed.Empty();
@@ -262,25 +586,28 @@ void ARandomMapGenerator::ClearGeneratorState()
     // *** NEW: Clear cave locations ***
     CaveLocations.Empty();
 
-    // *** UPDATED: Clear chunk ISM system ***
+    // *** UPDATED: Clear chunk ISM system - components go back to the pool for the next seed ***
     for (auto& ChunkPair : ChunkISMSystem)
     {
-        FChunkISMData& ChunkData = ChunkPair.Value;
-        for (auto& ISMPair : ChunkData.ChunkISMs)
+        ReleaseChunkISMs(ChunkPair.Key, ChunkPair.Value);
+    }
+    ChunkISMSystem.Empty();
+
+    // Merged chunk mesh'lerini temizle
+    for (auto& ChunkPair : Chunks)
+    {
+        if (ChunkPair.Value.Mesh)
         {
-            if (ISMPair.Value)
-            {
-                ISMPair.Value->ClearInstances();
-                ISMPair.Value->DestroyComponent();
-            }
+            ChunkPair.Value.Mesh->DestroyComponent();
         }
     }
-    ChunkISMSystem.Empty();
+    Chunks.Empty();
 
     bServerGenerationComplete = false;
     bClientGenerationComplete = false;
 
-    UE_LOG(LogTemp, Display, TEXT("Generator state cleared - chunk ISM system and cave locations reset"));
+    UE_LOG(LogTemp, Display, TEXT("Generator state cleared - chunk ISM system and cave locations reset (%d chunk ISMs pooled)"),
+        PooledChunkISMs.Num());
 }
 
 bool ARandomMapGenerator::ServerGenerateWorld_Validate()
@@ -291,9 +618,15 @@ bool ARandomMapGenerator::ServerGenerateWorld_Validate()
 void ARandomMapGenerator::ServerGenerateWorld_Implementation()
 {
     // Only server can initiate world generation
-    if (!HasAuthority() || bIsGeneratingWorld)
+    if (!HasAuthority())
         return;
 
+    // Üretim artık birkaç frame sürüyor - yeni seed ile çağrılırsa yarıdaki üretimi baştan başlat
+    if (bIsGeneratingWorld)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SERVER: World generation already running - restarting with seed %d"), Seed);
+    }
+
     LogDebugMessage(EDebugCategory::WorldGeneration,
         FString::Printf(TEXT("Server: Starting world generation with seed: %d"), Seed));
 
@@ -307,6 +640,9 @@ void ARandomMapGenerator::ServerGenerateWorld_Implementation()
     ChunksToGenerate = WorldSizeInChunks * WorldSizeInChunks;
     ChunksGenerated = 0;
 
+    // Üretim sırasında sadece blok verisi yazılır; görünür instance'lar en sonda tek geçişte oluşturulur
+    bDeferBlockInstances = true;
+
     // Seed'i başlatmanın birkaç farklı yolu (daha sağlam olması için)
     FMath::RandInit(Seed);
     RandomStream.Initialize(Seed);
@@ -322,51 +658,21 @@ void ARandomMapGenerator::ServerGenerateWorld_Implementation()
             FString::Printf(TEXT("Sample terrain height at (%d,%d): %d"), i, i, Height));
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 1. Normal chunk generation başlıyor..."));
-
-    // Generate all chunks
-    for (int32 X = 0; X < WorldSizeInChunks; X++)
-    {
-        for (int32 Y = 0; Y < WorldSizeInChunks; Y++)
-        {
-            FChunkCoord ChunkCoord(X, Y);
-            GenerateChunk(ChunkCoord);
-
-            // Update progress
-            ChunksGenerated++;
-            float Progress = static_cast<float>(ChunksGenerated) / ChunksToGenerate;
-            OnGenerationProgressUpdated.Broadcast(Progress);
-        }
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 2. Base Core spawn ediliyor..."));
-    // Base Core'u spawn et
-    SpawnBaseCore();
-
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 3. Spawn points oluşturuluyor..."));
-    // Generate spawn points (Debug amaçlı) - SADECE DEBUG GÖRSELLEŞTİRME
-    GenerateSpawnPoints();
-
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 4. Mountain Border System başlatılıyor..."));
-    // *** YENİ MOUNTAIN BORDER SİSTEMİ ***
-    if (bCreateMountainBorders)
-    {
-        GenerateMountainBorderSystem();
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 5. AI Debug walls kontrol ediliyor..."));
-    // AI Debug Modunda duvarlar oluştur
-    if (bAIDebugMode)
-    {
-        GenerateDebugWalls();
-    }
+    // Chunk'lar, base core, dağlar vb. Tick'te frame bütçesi içinde üretilir
+    StartWorldGenerationStages();
+}
 
-    UE_LOG(LogTemp, Warning, TEXT("SERVER: 6. All chunks generated with chunk-based ISM system!"));
+void ARandomMapGenerator::FinishServerWorldGeneration()
+{
+    UE_LOG(LogTemp, Warning, TEXT("SERVER: 7. All chunks generated with chunk-based ISM system!"));
 
     bIsGeneratingWorld = false;
     bHasGeneratedWorld = true;
     bWorldGenerationComplete = true;  // This will be replicated to clients
 
+    // Client'lar kendi ürettikleri chunk'ları bu hash'lerle karşılaştırır
+    PublishChunkHashes(true);
+
     // Notify all clients that generation is complete
     MulticastGenerationComplete();
 
@@ -404,6 +710,7 @@ void ARandomMapGenerator::ClientGenerateWorld()
     bIsGeneratingWorld = true;
     ChunksToGenerate = WorldSizeInChunks * WorldSizeInChunks;
     ChunksGenerated = 0;
+    bDeferBlockInstances = true;
     // Set random seed - CRITICAL: must use the same seed as server
     FMath::RandInit(Seed);
     RandomStream.Initialize(Seed);
@@ -415,36 +722,13 @@ void ARandomMapGenerator::ClientGenerateWorld()
         UE_LOG(LogTemp, Display, TEXT("Sample terrain height at (%d,%d): %d"), i, i, Height);
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("CLIENT: 1. Normal chunk generation başlıyor..."));
-    // Generate all chunks - same deterministic algorithm as server
-    for (int32 X = 0; X < WorldSizeInChunks; X++)
-    {
-        for (int32 Y = 0; Y < WorldSizeInChunks; Y++)
-        {
-            FChunkCoord ChunkCoord(X, Y);
-            GenerateChunk(ChunkCoord);
-            // Update progress
-            ChunksGenerated++;
-            float Progress = static_cast<float>(ChunksGenerated) / ChunksToGenerate;
-            OnGenerationProgressUpdated.Broadcast(Progress);
-        }
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("CLIENT: 2. AI Debug walls kontrol ediliyor..."));
-    // AI Debug Modunda duvarlar oluştur - client da oluştursun
-    if (bAIDebugMode)
-    {
-        GenerateDebugWalls();
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("CLIENT: 3. Mountain Border System başlatılıyor..."));
-    // *** YENİ MOUNTAIN BORDER SİSTEMİ ***
-    if (bCreateMountainBorders)
-    {
-        GenerateMountainBorderSystem();
-    }
+    // Same deterministic stages as the server, sliced over frames in Tick
+    StartWorldGenerationStages();
+}
 
-    UE_LOG(LogTemp, Warning, TEXT("CLIENT: 4. All chunks generated with chunk-based ISM system!"));
+void ARandomMapGenerator::FinishClientWorldGeneration()
+{
+    UE_LOG(LogTemp, Warning, TEXT("CLIENT: 5. All chunks generated with chunk-based ISM system!"));
 
     bIsGeneratingWorld = false;
     bHasGeneratedWorld = true;
@@ -452,6 +736,22 @@ void ARandomMapGenerator::ClientGenerateWorld()
     // Client generation complete
     bClientGenerationComplete = true;
 
+    // Seed'den üretilen dünyada bağlanmadan önceki edit'ler yok - server'dan journal iste (Tick'te).
+    // Üretim sırasında gelen block delta'ları journal uygulandıktan sonra sırayla uygulanır.
+    // Fast array modunda geç katılanlar tüm listeyi property olarak zaten alır
+    bAwaitingEditJournal = !HasAuthority() && !bReplicateBlockEditsAsFastArray;
+    bEditJournalRequested = false;
+
+    // Üretimden önce gelen item'ların callback'leri ClearGeneratorState'te düştü ve değişmeyen item'lar tekrar
+    // gönderilmez - replicate edilmiş liste zaten server'ın tamamı, oradan yeniden kuyrukla (Tick'te uygulanır)
+    if (!HasAuthority() && bReplicateBlockEditsAsFastArray)
+    {
+        for (const FReplicatedBlockEdit& Edit : ReplicatedBlockEdits.Items)
+        {
+            PendingReplicatedBlockEdits.Add(Edit.BlockKey, Edit);
+        }
+    }
+
     // Client-specific events
     OnClientWorldGenerationComplete.Broadcast();
     OnPlayerWorldGenerationComplete.Broadcast(false); // false = client
@@ -467,51 +767,391 @@ void ARandomMapGenerator::ClientGenerateWorld()
     UE_LOG(LogTemp, Warning, TEXT("CLIENT: *** WORLD GENERATION COMPLETE ***"));
 }
 
-void ARandomMapGenerator::MulticastGenerationComplete_Implementation()
+// *** NEW: TIME-SLICED WORLD GENERATION ***
+// Üretim bir stage makinesi: Tick her frame GenerationBudgetMs kadar ilerletir, progress her chunk ve stage'de yayınlanır.
+// Server ve client aynı stage tablosunu kullanır; bağımlılıklar stage'lerin okuduğu/yazdığı chunk bölgelerinden çıkarılır.
+
+// Declaration order is the tie-break when several stages are ready
+static const FWorldGenerationStageDesc GenerationPipeline[] =
 {
-    // This will run on all clients
-    if (!HasAuthority())
-    {
-        // Clients don't need to do anything here since they'll respond to 
-        // OnRep_WorldGenerationComplete instead
-        UE_LOG(LogTemp, Display, TEXT("Client received MulticastGenerationComplete notification"));
-    }
+    // Stage                                        Server Client Reads                                                                          Writes
+    { EWorldGenerationStage::Chunks,                true,  true,  EGenerationRegion::None,                                                       EGenerationRegion::MapInterior | EGenerationRegion::MapCenter | EGenerationRegion::MapEdge },
+    { EWorldGenerationStage::BaseCore,              true,  true,  EGenerationRegion::MapCenter,                                                  EGenerationRegion::MapCenter },
+    { EWorldGenerationStage::MountainBorders,       true,  true,  EGenerationRegion::MapEdge,                                                    EGenerationRegion::Border },
+    { EWorldGenerationStage::Caves,                 true,  true,  EGenerationRegion::MapEdge | EGenerationRegion::Border,                        EGenerationRegion::MapEdge | EGenerationRegion::Border | EGenerationRegion::Actors },
+    { EWorldGenerationStage::SpawnPoints,           true,  false, EGenerationRegion::MapCenter | EGenerationRegion::MapEdge,                     EGenerationRegion::Actors },
+    { EWorldGenerationStage::DebugWalls,            true,  true,  EGenerationRegion::MapCenter | EGenerationRegion::Actors,                      EGenerationRegion::MapCenter },
+    { EWorldGenerationStage::ChunkBuilds,           true,  true,  EGenerationRegion::All,                                                        EGenerationRegion::None },
+};
+
+static uint32 GetStageBit(EWorldGenerationStage Stage)
+{
+    return 1u << static_cast<uint8>(Stage);
 }
 
-// *** ENHANCED MOUNTAIN BORDER SYSTEM & CAVE IMPLEMENTATION ***
+static FString GetStageName(EWorldGenerationStage Stage)
+{
+    return UEnum::GetValueAsString(Stage).Replace(TEXT("EWorldGenerationStage::"), TEXT(""));
+}
 
-void ARandomMapGenerator::GenerateMountainBorderSystem()
+// Voxel stages whose result the world cache stores (SpawnPoints / DebugWalls depend on actors and always run)
+static uint32 GetWorldCacheStageMask()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Mountain Border System oluşturuluyor..."));
+    return GetStageBit(EWorldGenerationStage::Chunks) | GetStageBit(EWorldGenerationStage::BaseCore) |
+        GetStageBit(EWorldGenerationStage::MountainBorders) | GetStageBit(EWorldGenerationStage::Caves);
+}
 
-    LogDebugMessage(EDebugCategory::WorldGeneration, TEXT("Starting Mountain Border System generation"));
+void ARandomMapGenerator::StartWorldGenerationStages()
+{
+    NextChunkToGenerate = 0;
+    GenerationStepsDone = 0;
+    CompletedGenerationStages = 0;
+    GenerationStageSeconds.Empty();
+
+    // Tam grid ya da (streaming) başlangıçta görünür olan chunk'lar
+    BuildChunkGenerationOrder();
+    ChunksToGenerate = ChunkGenerationOrder.Num();
+
+    // Bağımlılıklar: önceki bir stage'in yazdığını okuyan (RAW), aynı bölgeye yazan (WAW)
+    // ya da okuduğuna yazan (WAR) stage ondan sonra çalışmalı
+    GenerationStageDependencies.Empty();
+    for (int32 i = 0; i < UE_ARRAY_COUNT(GenerationPipeline); i++)
+    {
+        const FWorldGenerationStageDesc& Desc = GenerationPipeline[i];
+        if (!IsGenerationStageEnabled(Desc))
+        {
+            // Çalışmayacak stage'ler tamamlanmış sayılır
+            CompletedGenerationStages |= GetStageBit(Desc.Stage);
+            continue;
+        }
 
-    // Önce dağ sistemini oluştur
-    for (int32 EdgeIndex = 0; EdgeIndex < 4; EdgeIndex++)
+        uint32 Dependencies = 0;
+        for (int32 j = 0; j < i; j++)
+        {
+            const FWorldGenerationStageDesc& Earlier = GenerationPipeline[j];
+            if (IsGenerationStageEnabled(Earlier) &&
+                ((Desc.Reads & Earlier.Writes) || (Desc.Writes & Earlier.Writes) || (Desc.Writes & Earlier.Reads)))
+            {
+                Dependencies |= GetStageBit(Earlier.Stage);
+            }
+        }
+        GenerationStageDependencies.Add(Desc.Stage, Dependencies);
+
+        LogDebugMessage(EDebugCategory::WorldGeneration,
+            FString::Printf(TEXT("Generation stage %s: dependency mask 0x%02x"), *GetStageName(Desc.Stage), Dependencies));
+    }
+
+    // Aynı seed ve ayarlarla daha önce üretildiyse voxel stage'leri diskten yükle
+    if (bUseWorldCache && !bStreamWorld && LoadWorldCache())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Mountain Edge %d oluşturuluyor..."), EdgeIndex);
-        GenerateMountainRange(EdgeIndex);
+        CompletedGenerationStages |= GetWorldCacheStageMask();
+        NextChunkToGenerate = ChunksToGenerate;
+        ChunksGenerated = ChunksToGenerate;
+        bBaseCoreAreaFlattened = true;
+        GeneratedEdgeFeatures = 0xF;
     }
 
-    // Sonra mağara sistemini oluştur (dağ bloklarını kaldırır)
-    UE_LOG(LogTemp, Warning, TEXT("Enhanced Cave System oluşturuluyor..."));
-    GenerateCaveSystem();
+    // Chunk yoksa (boş streaming seti) terrain stage'i hemen tamamlanır
+    if (ChunksToGenerate == 0)
+    {
+        CompletedGenerationStages |= GetStageBit(EWorldGenerationStage::Chunks);
+    }
 
-    LogDebugMessage(EDebugCategory::WorldGeneration, TEXT("Mountain Border System generation complete"));
-    UE_LOG(LogTemp, Warning, TEXT("Mountain Border System tamamlandı!"));
+    // Adımlar: her chunk üretimi + her özellik stage'i + her chunk build commit'i (cache'ten gelenler hariç)
+    int32 NumFeatureStages = 0;
+    for (const FWorldGenerationStageDesc& Desc : GenerationPipeline)
+    {
+        if (!(CompletedGenerationStages & GetStageBit(Desc.Stage)) &&
+            Desc.Stage != EWorldGenerationStage::Chunks && Desc.Stage != EWorldGenerationStage::ChunkBuilds)
+        {
+            NumFeatureStages += GetGenerationStageSteps(Desc.Stage);
+        }
+    }
+    const int32 ChunkSteps = (CompletedGenerationStages & GetStageBit(EWorldGenerationStage::Chunks)) ? 0 : ChunksToGenerate;
+    GenerationStepsTotal = ChunkSteps + NumFeatureStages + ChunksToGenerate;
+
+    OnGenerationProgressUpdated.Broadcast(0.0f);
+    EnterGenerationStage(GetNextGenerationStage());
 }
 
-void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
+bool ARandomMapGenerator::IsGenerationStageEnabled(const FWorldGenerationStageDesc& Desc) const
 {
-    // Harita sınırlarını hesapla
-    int32 MapMinX = 0;
-    int32 MapMinY = 0;
-    int32 MapMaxX = WorldSizeInChunks * ChunkSize - 1;
-    int32 MapMaxY = WorldSizeInChunks * ChunkSize - 1;
+    if (!(HasAuthority() ? Desc.bRunsOnServer : Desc.bRunsOnClient))
+        return false;
 
-    LogDebugMessage(EDebugCategory::WorldGeneration,
-        FString::Printf(TEXT("Generating mountain range for edge %d - Map bounds: (%d,%d) to (%d,%d)"),
-            EdgeIndex, MapMinX, MapMinY, MapMaxX, MapMaxY));
+    switch (Desc.Stage)
+    {
+    case EWorldGenerationStage::MountainBorders:
+    case EWorldGenerationStage::Caves:
+        // Streaming client'larda dağ kenarları oyuncu yaklaştıkça üretilir (server'a mağara spawn noktaları için hepsi lazım)
+        return bCreateMountainBorders && !(bStreamWorld && !HasAuthority());
+    case EWorldGenerationStage::DebugWalls:
+        return bAIDebugMode;
+    default:
+        return true;
+    }
+}
+
+EWorldGenerationStage ARandomMapGenerator::GetNextGenerationStage() const
+{
+    for (const FWorldGenerationStageDesc& Desc : GenerationPipeline)
+    {
+        if (CompletedGenerationStages & GetStageBit(Desc.Stage))
+            continue;
+
+        const uint32* Dependencies = GenerationStageDependencies.Find(Desc.Stage);
+        if (Dependencies && (*Dependencies & ~CompletedGenerationStages) == 0)
+        {
+            return Desc.Stage;
+        }
+    }
+
+    return EWorldGenerationStage::None;
+}
+
+int32 ARandomMapGenerator::GetGenerationStageSteps(EWorldGenerationStage Stage) const
+{
+    switch (Stage)
+    {
+    case EWorldGenerationStage::MountainBorders:
+        return 4;
+    case EWorldGenerationStage::Caves:
+        // Mağarasız ayarda da rapor/tamamlanma için bir adım
+        return FMath::Max(4 * FMath::Max(CavesPerEdge, 0), 1);
+    default:
+        return 1;
+    }
+}
+
+void ARandomMapGenerator::EnterGenerationStage(EWorldGenerationStage Stage)
+{
+    GenerationStage = Stage;
+    GenerationStageStep = 0;
+    GenerationStageStartTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogTemp, Warning, TEXT("%s: Generation stage %s"),
+        HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"), *GetStageName(Stage));
+
+    OnGenerationStageChanged.Broadcast(Stage);
+}
+
+void ARandomMapGenerator::CompleteGenerationStage()
+{
+    if (GenerationStage == EWorldGenerationStage::None)
+        return;
+
+    // Time-sliced stage'lerde frame'ler arası bekleme de dahil (duvar saati)
+    GenerationStageSeconds.Add(GenerationStage, static_cast<float>(FPlatformTime::Seconds() - GenerationStageStartTime));
+    CompletedGenerationStages |= GetStageBit(GenerationStage);
+
+    // Cache'lenen stage'lerin hepsi bitti - sonraki stage'ler (spawn, debug duvarları) voxel'e dokunmadan önce kaydet
+    const uint32 CacheMask = GetWorldCacheStageMask();
+    if (bUseWorldCache && !bStreamWorld && !bLoadedFromWorldCache && !bSavedWorldCache &&
+        (CompletedGenerationStages & CacheMask) == CacheMask)
+    {
+        SaveWorldCache();
+    }
+}
+
+void ARandomMapGenerator::LogGenerationStageTimes() const
+{
+    float TotalSeconds = 0.0f;
+    for (const FWorldGenerationStageDesc& Desc : GenerationPipeline)
+    {
+        if (const float* Seconds = GenerationStageSeconds.Find(Desc.Stage))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("%s: Stage %-16s %8.2f ms"),
+                HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"), *GetStageName(Desc.Stage), *Seconds * 1000.0f);
+            TotalSeconds += *Seconds;
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("%s: World generation took %.2f ms"),
+        HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"), TotalSeconds * 1000.0f);
+}
+
+void ARandomMapGenerator::AdvanceWorldGeneration()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    // Bütçe 0 ise eski davranış: tüm üretim tek frame'de
+    const double BudgetSeconds = GenerationBudgetMs > 0.0f ? GenerationBudgetMs / 1000.0 : DBL_MAX;
+
+    while (GenerationStage != EWorldGenerationStage::None && !bAwaitingChunkBuilds)
+    {
+        RunGenerationStep();
+
+        if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+}
+
+void ARandomMapGenerator::RunGenerationStep()
+{
+    switch (GenerationStage)
+    {
+    case EWorldGenerationStage::Chunks:
+    {
+        // Chunk'lar birbirinden bağımsız (FGenerationRandom) - bir batch tüm çekirdeklerde paralel üretilir
+        const int32 BatchSize = bParallelChunkFill
+            ? FMath::Min(ChunksToGenerate - NextChunkToGenerate, (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) * 2)
+            : 1;
+
+        TArray<FChunkCoord> BatchCoords(ChunkGenerationOrder.GetData() + NextChunkToGenerate, BatchSize);
+
+        GenerateChunksParallel(BatchCoords);
+
+        NextChunkToGenerate += BatchSize;
+        ChunksGenerated += BatchSize;
+        AddGenerationProgress(BatchSize);
+
+        if (NextChunkToGenerate >= ChunksToGenerate)
+        {
+            CompleteGenerationStage();
+            EnterGenerationStage(GetNextGenerationStage());
+        }
+        return;
+    }
+
+    case EWorldGenerationStage::BaseCore:
+        // Base Core alanını düzleştir (actor SpawnPoints stage'inde, sadece server'da)
+        FlattenBaseCoreArea();
+        break;
+
+    case EWorldGenerationStage::MountainBorders:
+        // *** YENİ MOUNTAIN BORDER SİSTEMİ ***
+        // Adım başına bir kenar - terrain'deki chunk adımları gibi bütçe kenarlar arasında kontrol edilir
+        GenerateMountainRange(GenerationStageStep);
+        if (++GenerationStageStep < GetGenerationStageSteps(GenerationStage))
+        {
+            AddGenerationProgress();
+            return;
+        }
+        break;
+
+    case EWorldGenerationStage::Caves:
+    {
+        // Mağaralar dağ bloklarını kaldırır, girişleri mühürler ve CaveLocations'ı doldurur.
+        // Adım başına bir mağara, GenerateCaveSystem ile aynı sırada (kenar kenar) - CaveLocations aynı çıkar
+        if (GenerationStageStep == 0)
+        {
+            CaveLocations.Empty();
+        }
+
+        const int32 CavesOnEdge = FMath::Max(CavesPerEdge, 0);
+        if (GenerationStageStep < 4 * CavesOnEdge)
+        {
+            const int32 EdgeIndex = GenerationStageStep / CavesOnEdge;
+            const int32 CaveIndex = GenerationStageStep % CavesOnEdge;
+            GenerateEnhancedCave(EdgeIndex, (CaveIndex + 1.0f) / (CavesOnEdge + 1.0f));
+        }
+
+        if (++GenerationStageStep < GetGenerationStageSteps(GenerationStage))
+        {
+            AddGenerationProgress();
+            return;
+        }
+
+        LogCaveSystemReport();
+        GeneratedEdgeFeatures = 0xF;
+        break;
+    }
+
+    case EWorldGenerationStage::SpawnPoints:
+        // Base Core'u spawn et
+        SpawnBaseCore();
+        // Generate spawn points (Debug amaçlı) - SADECE DEBUG GÖRSELLEŞTİRME
+        GenerateSpawnPoints();
+        break;
+
+    case EWorldGenerationStage::DebugWalls:
+        // AI Debug Modunda duvarlar oluştur
+        GenerateDebugWalls();
+        break;
+
+    case EWorldGenerationStage::ChunkBuilds:
+        // Hidden-face culling - sadece görünür bloklar için instance oluşturuluyor
+        bDeferBlockInstances = false;
+        BuildAllChunkInstances();
+
+        // Chunk geometrisi worker thread'lerde üretiliyor - tamamlanma event'leri build'ler commit edilince Tick'te yayınlanır
+        bAwaitingChunkBuilds = true;
+        return;
+
+    default:
+        GenerationStage = EWorldGenerationStage::None;
+        return;
+    }
+
+    AddGenerationProgress();
+    CompleteGenerationStage();
+    EnterGenerationStage(GetNextGenerationStage());
+}
+
+void ARandomMapGenerator::AddGenerationProgress(int32 Steps)
+{
+    // 1.0 tamamlanma event'leriyle birlikte yayınlanır; border chunk build'leri toplamı aşabilir
+    GenerationStepsDone = FMath::Min(GenerationStepsDone + Steps, FMath::Max(GenerationStepsTotal - 1, 0));
+
+    const float Progress = GenerationStepsTotal > 0 ? static_cast<float>(GenerationStepsDone) / GenerationStepsTotal : 0.0f;
+    OnGenerationProgressUpdated.Broadcast(Progress);
+}
+
+void ARandomMapGenerator::MulticastGenerationComplete_Implementation()
+{
+    // This will run on all clients
+    if (!HasAuthority())
+    {
+        // Clients don't need to do anything here since they'll respond to 
+        // OnRep_WorldGenerationComplete instead
+        UE_LOG(LogTemp, Display, TEXT("Client received MulticastGenerationComplete notification"));
+    }
+}
+
+// *** ENHANCED MOUNTAIN BORDER SYSTEM & CAVE IMPLEMENTATION ***
+
+void ARandomMapGenerator::GenerateMountainBorderSystem()
+{
+    UE_LOG(LogTemp, Warning, TEXT("Mountain Border System oluşturuluyor..."));
+
+    LogDebugMessage(EDebugCategory::WorldGeneration, TEXT("Starting Mountain Border System generation"));
+
+    // Önce dağ sistemini oluştur
+    for (int32 EdgeIndex = 0; EdgeIndex < 4; EdgeIndex++)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Mountain Edge %d oluşturuluyor..."), EdgeIndex);
+        GenerateMountainRange(EdgeIndex);
+    }
+
+    // Sonra mağara sistemini oluştur (dağ bloklarını kaldırır)
+    UE_LOG(LogTemp, Warning, TEXT("Enhanced Cave System oluşturuluyor..."));
+    GenerateCaveSystem();
+
+    // Streaming'in bu kenarları tekrar üretmemesi için
+    GeneratedEdgeFeatures = 0xF;
+
+    // Üretim dışında (Blueprint'ten) çağrıldıysa sadece voxel verisi değişti - chunk geometrisini yeniden oluştur
+    if (!bDeferBlockInstances)
+    {
+        BuildAllChunkInstances();
+    }
+
+    LogDebugMessage(EDebugCategory::WorldGeneration, TEXT("Mountain Border System generation complete"));
+    UE_LOG(LogTemp, Warning, TEXT("Mountain Border System tamamlandı!"));
+}
+
+void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
+{
+    // Harita sınırlarını hesapla
+    int32 MapMinX = 0;
+    int32 MapMinY = 0;
+    int32 MapMaxX = WorldSizeInChunks * ChunkSize - 1;
+    int32 MapMaxY = WorldSizeInChunks * ChunkSize - 1;
+
+    LogDebugMessage(EDebugCategory::WorldGeneration,
+        FString::Printf(TEXT("Generating mountain range for edge %d - Map bounds: (%d,%d) to (%d,%d)"),
+            EdgeIndex, MapMinX, MapMinY, MapMaxX, MapMaxY));
 
     int32 BlocksGenerated = 0;
 
@@ -540,7 +1180,7 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                 int32 MountainHeight = GetMountainHeight(X, Y, Depth);
 
                 // Zemin referans yüksekliği
-                int32 BaseGroundHeight = GetTerrainHeight(FMath::Clamp(X, MapMinX, MapMaxX), MapMinY);
+                int32 BaseGroundHeight = GetCachedTerrainHeight(FMath::Clamp(X, MapMinX, MapMaxX), MapMinY);
 
                 // Dağ bloklarını oluştur
                 for (int32 Z = 0; Z < MountainHeight; Z++)
@@ -550,9 +1190,6 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
 
                     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
 
-                    // *** UPDATED: Direct chunk ISM addition instead of batch ***
-                    UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
-
                     BlocksGenerated++;
                 }
             }
@@ -578,7 +1215,7 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                 if (LocalY < 0) LocalY += ChunkSize;
 
                 int32 MountainHeight = GetMountainHeight(X, Y, Depth);
-                int32 BaseGroundHeight = GetTerrainHeight(FMath::Clamp(X, MapMinX, MapMaxX), MapMaxY);
+                int32 BaseGroundHeight = GetCachedTerrainHeight(FMath::Clamp(X, MapMinX, MapMaxX), MapMaxY);
 
                 for (int32 Z = 0; Z < MountainHeight; Z++)
                 {
@@ -586,7 +1223,6 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                     EBlockType BlockType = GetMountainBlockType(Z, MountainHeight, LocalX, LocalY);
 
                     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-                    UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
 
                     BlocksGenerated++;
                 }
@@ -613,7 +1249,7 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                 if (LocalY < 0) LocalY += ChunkSize;
 
                 int32 MountainHeight = GetMountainHeight(X, Y, Depth);
-                int32 BaseGroundHeight = GetTerrainHeight(MapMinX, FMath::Clamp(Y, MapMinY, MapMaxY));
+                int32 BaseGroundHeight = GetCachedTerrainHeight(MapMinX, FMath::Clamp(Y, MapMinY, MapMaxY));
 
                 for (int32 Z = 0; Z < MountainHeight; Z++)
                 {
@@ -621,7 +1257,6 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                     EBlockType BlockType = GetMountainBlockType(Z, MountainHeight, LocalX, LocalY);
 
                     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-                    UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
 
                     BlocksGenerated++;
                 }
@@ -648,7 +1283,7 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                 if (LocalY < 0) LocalY += ChunkSize;
 
                 int32 MountainHeight = GetMountainHeight(X, Y, Depth);
-                int32 BaseGroundHeight = GetTerrainHeight(MapMaxX, FMath::Clamp(Y, MapMinY, MapMaxY));
+                int32 BaseGroundHeight = GetCachedTerrainHeight(MapMaxX, FMath::Clamp(Y, MapMinY, MapMaxY));
 
                 for (int32 Z = 0; Z < MountainHeight; Z++)
                 {
@@ -656,7 +1291,6 @@ void ARandomMapGenerator::GenerateMountainRange(int32 EdgeIndex)
                     EBlockType BlockType = GetMountainBlockType(Z, MountainHeight, LocalX, LocalY);
 
                     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-                    UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
 
                     BlocksGenerated++;
                 }
@@ -681,22 +1315,14 @@ void ARandomMapGenerator::GenerateCaveSystem()
     // Her kenarda CavesPerEdge kadar mağara oluştur
     for (int32 EdgeIndex = 0; EdgeIndex < 4; EdgeIndex++)
     {
-        if (CavesPerEdge == 1)
-        {
-            // Tek mağara - kenarın ortasında
-            GenerateEnhancedCave(EdgeIndex, 0.5f);
-        }
-        else
-        {
-            // Çoklu mağaralar - kenarda eşit aralıklarla dağıt
-            for (int32 CaveIndex = 0; CaveIndex < CavesPerEdge; CaveIndex++)
-            {
-                float EdgePosition = (CaveIndex + 1.0f) / (CavesPerEdge + 1.0f); // 0.2, 0.4, 0.6, 0.8 gibi
-                GenerateEnhancedCave(EdgeIndex, EdgePosition);
-            }
-        }
+        GenerateEdgeCaves(EdgeIndex);
     }
 
+    LogCaveSystemReport();
+}
+
+void ARandomMapGenerator::LogCaveSystemReport() const
+{
     // *** NEW: CAVE SYSTEM GENERATION REPORT ***
     UE_LOG(LogTemp, Warning, TEXT("=== CAVE SYSTEM GENERATION REPORT ==="));
     UE_LOG(LogTemp, Warning, TEXT("Caves per edge: %d"), CavesPerEdge);
@@ -718,6 +1344,24 @@ void ARandomMapGenerator::GenerateCaveSystem()
         CavesPerEdge, CaveLocations.Num());
 }
 
+void ARandomMapGenerator::GenerateEdgeCaves(int32 EdgeIndex)
+{
+    if (CavesPerEdge == 1)
+    {
+        // Tek mağara - kenarın ortasında
+        GenerateEnhancedCave(EdgeIndex, 0.5f);
+    }
+    else
+    {
+        // Çoklu mağaralar - kenarda eşit aralıklarla dağıt
+        for (int32 CaveIndex = 0; CaveIndex < CavesPerEdge; CaveIndex++)
+        {
+            float EdgePosition = (CaveIndex + 1.0f) / (CavesPerEdge + 1.0f); // 0.2, 0.4, 0.6, 0.8 gibi
+            GenerateEnhancedCave(EdgeIndex, EdgePosition);
+        }
+    }
+}
+
 void ARandomMapGenerator::GenerateEnhancedCave(int32 EdgeIndex, float EdgePosition)
 {
     // Harita sınırlarını hesapla
@@ -773,7 +1417,7 @@ void ARandomMapGenerator::GenerateEnhancedCave(int32 EdgeIndex, float EdgePositi
         *EdgeName, CaveStartX, CaveStartY, EdgePosition);
 
     // Zemin referans yüksekliği
-    int32 CaveBaseHeight = GetTerrainHeight(
+    int32 CaveBaseHeight = GetCachedTerrainHeight(
         FMath::Clamp(CaveStartX, MapMinX, MapMaxX),
         FMath::Clamp(CaveStartY, MapMinY, MapMaxY)
     );
@@ -901,9 +1545,6 @@ void ARandomMapGenerator::GenerateCaveRockyFormations(int32 CaveX, int32 CaveY,
 
                 SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, RockType);
 
-                // *** UPDATED: Direct chunk ISM addition ***
-                UpdateBlockInstance(ChunkCoord, BlockPos, RockType);
-
                 BlocksPlaced++;
             }
         }
@@ -1036,7 +1677,6 @@ void ARandomMapGenerator::GenerateNaturalCaveTunnel(int32 StartX, int32 StartY,
                     }
 
                     SetBlockInternalWithoutReplication(ChunkCoord, FloorBlockPos, FloorBlockType);
-                    UpdateBlockInstance(ChunkCoord, FloorBlockPos, FloorBlockType);
                     BlocksPlaced++;
                 }
             }
@@ -1049,8 +1689,6 @@ void ARandomMapGenerator::GenerateNaturalCaveTunnel(int32 StartX, int32 StartY,
 
                 if (ExistingBlockType != EBlockType::Air)
                 {
-                    // *** UPDATED: Use chunk-based removal ***
-                    RemoveBlockInstance(ChunkCoord, BlockPos, ExistingBlockType);
                     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, EBlockType::Air);
 
                     BlocksRemoved++;
@@ -1171,9 +1809,6 @@ void ARandomMapGenerator::PlaceInvisibleWall(const FChunkCoord& ChunkCoord, cons
     // Invisible wall bloğunu yerleştir
     SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, EBlockType::InvisibleWall);
 
-    // *** UPDATED: Direct chunk ISM addition ***
-    UpdateBlockInstance(ChunkCoord, BlockPos, EBlockType::InvisibleWall);
-
     UE_LOG(LogTemp, VeryVerbose, TEXT("Invisible wall placed at chunk (%d,%d) local (%d,%d,%d)"),
         ChunkCoord.X, ChunkCoord.Y, BlockPos.X, BlockPos.Y, BlockPos.Z);
 }
@@ -1298,27 +1933,88 @@ void ARandomMapGenerator::TestCaveSpawnSystem(int32 TestSpawnerCount)
 // *** UPDATED: CHUNK-BASED GENERATION ***
 void ARandomMapGenerator::GenerateChunk(const FChunkCoord& ChunkCoord)
 {
-    // *** UPDATED: Initialize chunk ISMs first ***
-    InitializeChunkISMs(ChunkCoord);
-
     // Create chunk info and mark as generated
-    FChunkInfo ChunkInfo(ChunkCoord);
+    FChunkInfo& ChunkInfo = FindOrAddChunkInfo(ChunkCoord);
     ChunkInfo.bIsGenerated = true;
-    ChunksInfo.Add(ChunkCoord, ChunkInfo);
+
+    FFeatureWriter Writer(ChunkCoord, ChunkInfo.Blocks, ChunkSize);
+    GenerateChunkBlocks(ChunkCoord, ChunkInfo, PendingFeatureWrites.Find(ChunkCoord), Writer);
+    PendingFeatureWrites.Remove(ChunkCoord);
+    MarkChunkHashDirty(ChunkCoord);
+
+    RouteFeatureWrites(ChunkCoord, Writer.OutgoingWrites);
+
+    UE_LOG(LogTemp, Display, TEXT("Chunk (%d,%d) generated with chunk-based ISM"), ChunkCoord.X, ChunkCoord.Y);
+}
+
+void ARandomMapGenerator::GenerateChunksParallel(const TArray<FChunkCoord>& ChunkCoords)
+{
+    // ChunksInfo game thread'de büyütülür; worker'lar sadece kendi chunk'larının verisine yazar
+    TArray<FChunkInfo*> ChunkInfos;
+    ChunkInfos.Reserve(ChunkCoords.Num());
+    for (const FChunkCoord& ChunkCoord : ChunkCoords)
+    {
+        FindOrAddChunkInfo(ChunkCoord);
+    }
+
+    // Komşu chunk'lardan bekleyen feature blokları (ParallelFor sırasında map değişmez, sadece okunur)
+    TArray<const TArray<FFeatureWriteBatch>*> IncomingWrites;
+    TArray<FFeatureWriter> Writers;
+    IncomingWrites.Reserve(ChunkCoords.Num());
+    Writers.Reserve(ChunkCoords.Num());
+    for (const FChunkCoord& ChunkCoord : ChunkCoords)
+    {
+        FChunkInfo& ChunkInfo = ChunksInfo[ChunkCoord];
+        ChunkInfo.bIsGenerated = true;
+        ChunkInfos.Add(&ChunkInfo);
+        IncomingWrites.Add(PendingFeatureWrites.Find(ChunkCoord));
+        Writers.Emplace(ChunkCoord, ChunkInfo.Blocks, ChunkSize);
+    }
+
+    ParallelFor(ChunkCoords.Num(), [this, &ChunkCoords, &ChunkInfos, &IncomingWrites, &Writers](int32 Index)
+    {
+        GenerateChunkBlocks(ChunkCoords[Index], *ChunkInfos[Index], IncomingWrites[Index], Writers[Index]);
+    }, bParallelChunkFill ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    // Chunk sırasıyla (deterministik) - aynı batch'teki komşulara doğrudan uygulanır
+    for (int32 Index = 0; Index < ChunkCoords.Num(); Index++)
+    {
+        PendingFeatureWrites.Remove(ChunkCoords[Index]);
+        MarkChunkHashDirty(ChunkCoords[Index]);
+    }
+    for (int32 Index = 0; Index < ChunkCoords.Num(); Index++)
+    {
+        RouteFeatureWrites(ChunkCoords[Index], Writers[Index].OutgoingWrites);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Generated %d chunks (%s)"),
+        ChunkCoords.Num(), bParallelChunkFill ? TEXT("parallel") : TEXT("game thread"));
+}
+
+void ARandomMapGenerator::GenerateChunkBlocks(const FChunkCoord& ChunkCoord, FChunkInfo& ChunkInfo, const TArray<FFeatureWriteBatch>* IncomingWrites, FFeatureWriter& Writer) const
+{
+    FChunkBlockStorage& ChunkBlocks = ChunkInfo.Blocks;
 
     // Her chunk için seed'e dayalı bir offset ekleyelim
-    int32 ChunkSpecificSeedModifier = (ChunkCoord.X * 73 + ChunkCoord.Y * 31 + Seed) % 1000;
+    int32 ChunkSpecificSeedModifier = GetChunkSeedModifier(ChunkCoord);
+
+    // Tüm kolonların yükseklikleri tek seferde (batched SIMD noise) - GetTerrainHeight ile birebir aynı
+    TArray<int32> TerrainHeights;
+    GetChunkTerrainHeights(ChunkCoord, ChunkSpecificSeedModifier, TerrainHeights);
+
+    // Heightmap cache'i: sonraki stage'ler ve spawn sorguları noise'u tekrar hesaplamaz
+    ChunkInfo.TerrainHeights.SetNumUninitialized(TerrainHeights.Num());
+    for (int32 Column = 0; Column < TerrainHeights.Num(); Column++)
+    {
+        ChunkInfo.TerrainHeights[Column] = static_cast<uint16>(TerrainHeights[Column]);
+    }
 
     // Generate terrain for this chunk
     for (int32 X = 0; X < ChunkSize; X++)
     {
         for (int32 Y = 0; Y < ChunkSize; Y++)
         {
-            // Calculate world coordinates
-            int32 WorldX = ChunkCoord.X * ChunkSize + X;
-            int32 WorldY = ChunkCoord.Y * ChunkSize + Y;
-            // Get height at this position (chunk specific modifier ile)
-            int32 TerrainHeight = GetTerrainHeight(WorldX, WorldY, ChunkSpecificSeedModifier);
+            const int32 TerrainHeight = TerrainHeights[X * ChunkSize + Y];
 
             // Generate blocks from bottom to top
             for (int32 Z = 0; Z < TerrainHeight; Z++)
@@ -1341,40 +2037,106 @@ void ARandomMapGenerator::GenerateChunk(const FChunkCoord& ChunkCoord)
                     BlockType = EBlockType::Dirt;
                 }
 
-                // Set block in chunk data
-                FBlockPosition BlockPos(X, Y, Z);
-                SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-
-                // *** UPDATED: Direct chunk ISM addition instead of batch ***
-                UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
+                // Set block in chunk data (direct dense write, chunk zaten mevcut)
+                ChunkBlocks.SetBlock(X, Y, Z, BlockType);
             }
+        }
+    }
+
+    // Ağaçlar arazi doldurulduktan sonra - yapraklar komşu kolonların üstüne taşabilir
+    const FGenerationRandom TreeRandom(Seed, FIntPoint(ChunkCoord.X, ChunkCoord.Y), EGenerationFeature::TreePlacement);
+    for (int32 X = 0; X < ChunkSize; X++)
+    {
+        for (int32 Y = 0; Y < ChunkSize; Y++)
+        {
+            int32 WorldX = ChunkCoord.X * ChunkSize + X;
+            int32 WorldY = ChunkCoord.Y * ChunkSize + Y;
 
             // Chance to generate a tree on grass blocks
             float LocalTreeDensity = TreeDensity * 0.05f *
                 (1.0f + FMath::Sin(WorldX * 0.02f + WorldY * 0.04f + Seed * 0.01f));
             LocalTreeDensity = FMath::Clamp(LocalTreeDensity, 0.0f, 0.1f);
 
-            if (RandomStream.GetFraction() < LocalTreeDensity)
+            if (TreeRandom.GetFraction(X * ChunkSize + Y) < LocalTreeDensity)
             {
-                GenerateTree(WorldX, WorldY, TerrainHeight);
+                PlaceTree(Writer, WorldX, WorldY, TerrainHeights[X * ChunkSize + Y]);
             }
         }
     }
 
-    UE_LOG(LogTemp, Display, TEXT("Chunk (%d,%d) generated with chunk-based ISM"), ChunkCoord.X, ChunkCoord.Y);
+    // Daha önce üretilmiş komşuların bu chunk'a taşan yaprakları
+    if (IncomingWrites)
+    {
+        for (const FFeatureWriteBatch& Batch : *IncomingWrites)
+        {
+            MergeFeatureWrites(ChunkInfo, Batch);
+        }
+    }
+
+    // Ağaçlar dahil en üst katı blok
+    RebuildSurfaceHeights(ChunkInfo);
+    ChunkInfo.ContentHash = ComputeChunkContentHash(ChunkBlocks);
 }
 
 void ARandomMapGenerator::GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ)
 {
+    // Oyun sırasında dikilen ağaç bir edit'tir: seed'den üretilmez, client'lara replicate edilmeli
+    if (!HasAuthority())
+        return;
+
     // Convert world coordinates to chunk coordinates
     FChunkCoord ChunkCoord(FMath::FloorToInt(static_cast<float>(WorldX) / ChunkSize),
         FMath::FloorToInt(static_cast<float>(WorldY) / ChunkSize));
-    // Convert world coordinates to local chunk coordinates
-    int32 LocalX = WorldX % ChunkSize;
-    int32 LocalY = WorldY % ChunkSize;
+
+    if (bStreamWorld)
+    {
+        EnsureChunkGenerated(ChunkCoord);
+    }
+
+    // Tüm bloklar toplanır, storage'a doğrudan yazılmaz
+    FFeatureWriter Writer(ChunkCoord, FindOrAddChunkInfo(ChunkCoord).Blocks, ChunkSize);
+    Writer.bCollectAllWrites = true;
+    PlaceTree(Writer, WorldX, WorldY, WorldZ);
+
+    for (const auto& TargetPair : Writer.OutgoingWrites)
+    {
+        const FChunkCoord TargetChunk(TargetPair.Key.X, TargetPair.Key.Y);
+
+        // Üretimdeki gibi harita dışına taşan yapraklar kırpılır
+        if (!IsChunkInsideMap(TargetChunk))
+            continue;
+
+        if (bStreamWorld)
+        {
+            EnsureChunkGenerated(TargetChunk);
+            EnsureEdgeFeaturesForChunk(TargetChunk);
+        }
+
+        for (const FFeatureBlockWrite& Write : TargetPair.Value)
+        {
+            const FBlockPosition BlockPos(Write.LocalPos.X, Write.LocalPos.Y, Write.LocalPos.Z);
+
+            // FFeatureWriter::ApplyBlock ile aynı kural: sadece Air doldurulur, gövde yaprağın yerini alır
+            const EBlockType OldBlockType = GetBlockInternal(TargetChunk, BlockPos);
+            if (OldBlockType != EBlockType::Air && !(OldBlockType == EBlockType::Leaves && Write.BlockType == EBlockType::Wood))
+                continue;
+
+            // Pinleme, hash ve heightmap SetBlockInternalWithoutReplication'da
+            SetBlockInternalWithoutReplication(TargetChunk, BlockPos, Write.BlockType);
+            BlockDamageData.Remove(FWorldBlockKey(TargetChunk, BlockPos));
+            RefreshBlockInstancesAround(TargetChunk, BlockPos, OldBlockType);
+            QueueBlockDelta(TargetChunk, BlockPos, Write.BlockType);
+        }
+    }
+}
+
+void ARandomMapGenerator::PlaceTree(FFeatureWriter& Writer, int32 WorldX, int32 WorldY, int32 WorldZ) const
+{
+    // Ağacın şekli sadece kendi kolonuna bağlı - hangi sırada/thread'de üretildiği fark etmez
+    FGenerationRandom TreeRandom(Seed, FIntPoint(WorldX, WorldY), EGenerationFeature::TreeShape);
 
     // Seed'e dayalı çeşitli ağaç yükseklikleri
-    int32 BaseTreeHeight = RandomStream.RandRange(3, 6);
+    int32 BaseTreeHeight = TreeRandom.RandRange(3, 6);
     int32 TreeHeightOffset = ((WorldX * 31) + (WorldY * 17) + Seed) % 3 - 1; // -1, 0, or 1
     int32 TreeHeight = FMath::Clamp(BaseTreeHeight + TreeHeightOffset, 3, 8);
 
@@ -1383,20 +2145,11 @@ void ARandomMapGenerator::GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ)
     // Generate trunk
     for (int32 Z = 0; Z < TreeHeight; Z++)
     {
-        FBlockPosition BlockPos(LocalX, LocalY, WorldZ + Z);
-        // Make sure we're in chunk bounds
-        if (BlockPos.Z < ChunkHeight)
-        {
-            // Set block data
-            SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, TrunkType);
-
-            // *** UPDATED: Direct chunk ISM addition ***
-            UpdateBlockInstance(ChunkCoord, BlockPos, TrunkType);
-        }
+        Writer.SetBlock(WorldX, WorldY, WorldZ + Z, TrunkType);
     }
 
     // Seed'e dayalı yaprak boyutu
-    int32 LeafSize = RandomStream.RandRange(2, 3);
+    int32 LeafSize = TreeRandom.RandRange(2, 3);
     EBlockType LeafType = EBlockType::Leaves;
 
     // Generate leaves (vary size based on seed)
@@ -1404,7 +2157,7 @@ void ARandomMapGenerator::GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ)
     {
         for (int32 LY = -LeafSize; LY <= LeafSize; LY++)
         {
-            int32 LeafHeight = RandomStream.RandRange(2, 3);
+            int32 LeafHeight = TreeRandom.RandRange(2, 3);
             for (int32 LZ = 0; LZ <= LeafHeight; LZ++)
             {
                 // Skip trunk positions
@@ -1413,25 +2166,11 @@ void ARandomMapGenerator::GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ)
 
                 // Kenarlar için daha az yaprak olasılığı (daha doğal ağaç şekli)
                 if ((FMath::Abs(LX) == LeafSize || FMath::Abs(LY) == LeafSize) &&
-                    RandomStream.GetFraction() > 0.4f)
+                    TreeRandom.GetFraction() > 0.4f)
                     continue;
 
-                int32 LeafX = LocalX + LX;
-                int32 LeafY = LocalY + LY;
-                int32 LeafZ = WorldZ + TreeHeight - 1 + LZ;
-
-                // Make sure leaves are within chunk bounds
-                if (LeafX >= 0 && LeafX < ChunkSize &&
-                    LeafY >= 0 && LeafY < ChunkSize &&
-                    LeafZ >= 0 && LeafZ < ChunkHeight)
-                {
-                    FBlockPosition BlockPos(LeafX, LeafY, LeafZ);
-                    // Set block data
-                    SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, LeafType);
-
-                    // *** UPDATED: Direct chunk ISM addition ***
-                    UpdateBlockInstance(ChunkCoord, BlockPos, LeafType);
-                }
+                // Komşu chunk'a taşan yapraklar da dahil (writer yönlendirir)
+                Writer.SetBlock(WorldX + LX, WorldY + LY, WorldZ + TreeHeight - 1 + LZ, LeafType);
             }
         }
     }
@@ -1439,261 +2178,2790 @@ void ARandomMapGenerator::GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ)
 
 int32 ARandomMapGenerator::GetTerrainHeight(int32 WorldX, int32 WorldY, int32 ChunkSeedModifier) const
 {
-    // Haritanın merkezini hesapla
-    int32 CenterWorldX = (WorldSizeInChunks * ChunkSize) / 2;
-    int32 CenterWorldY = (WorldSizeInChunks * ChunkSize) / 2;
+    // Apply Perlin noise to base height
+    float Noise = GetPerlinNoise(WorldX, WorldY);
 
-    // Merkeze olan mesafeyi hesapla
-    int32 DistanceX = abs(WorldX - CenterWorldX);
-    int32 DistanceY = abs(WorldY - CenterWorldY);
-    float Distance = FMath::Sqrt(static_cast<float>(DistanceX * DistanceX + DistanceY * DistanceY));
+    // Küçük bir ikincil gürültü ekleyelim (daha fazla detay için)
+    float SecondaryNoise = FTerrainNoise::Perlin2D(WorldX * 0.1f + Seed * 0.01f, WorldY * 0.1f);
+
+    return ComposeTerrainHeight(WorldX, WorldY, ChunkSeedModifier, Noise, SecondaryNoise);
+}
+
+void ARandomMapGenerator::GetChunkTerrainHeights(const FChunkCoord& ChunkCoord, int32 ChunkSeedModifier, TArray<int32>& OutHeights) const
+{
+    const int32 NumColumns = ChunkSize * ChunkSize;
+    OutHeights.SetNumUninitialized(NumColumns);
+
+    // GetPerlinNoise'daki seed parametreleri (aynı float işlemleri, aynı sıra)
+    const float XOffset = (Seed % 10000) * 0.01f;
+    const float YOffset = (Seed % 7919) * 0.01f;
+    const float SeedFactor = 1.0f + ((Seed % 1000) / 10000.0f);
+    const float ScaleModifier = 0.5f + (float)(Seed % 5000) / 10000.0f;
+
+    // Oktav başına bir giriş/çıkış dizisi: 3 Perlin oktavı + ikincil gürültü
+    TArray<float> Inputs;
+    Inputs.SetNumUninitialized(NumColumns * 8);
+    TArray<float> Noise;
+    Noise.SetNumUninitialized(NumColumns * 4);
+
+    float* X1 = Inputs.GetData();
+    float* Y1 = X1 + NumColumns;
+    float* X2 = Y1 + NumColumns;
+    float* Y2 = X2 + NumColumns;
+    float* X3 = Y2 + NumColumns;
+    float* Y3 = X3 + NumColumns;
+    float* XS = Y3 + NumColumns;
+    float* YS = XS + NumColumns;
+
+    for (int32 X = 0; X < ChunkSize; X++)
+    {
+        for (int32 Y = 0; Y < ChunkSize; Y++)
+        {
+            const int32 Column = X * ChunkSize + Y;
+            const int32 WorldX = ChunkCoord.X * ChunkSize + X;
+            const int32 WorldY = ChunkCoord.Y * ChunkSize + Y;
+
+            const float ScaledX = (static_cast<float>(WorldX) * NoiseScale * SeedFactor) + XOffset;
+            const float ScaledY = (static_cast<float>(WorldY) * NoiseScale * SeedFactor) + YOffset;
+
+            X1[Column] = ScaledX;
+            Y1[Column] = ScaledY;
+            X2[Column] = ScaledX * 2.0f * ScaleModifier;
+            Y2[Column] = ScaledY * 2.0f * ScaleModifier;
+            X3[Column] = ScaledX * 4.0f * (1.0f - ScaleModifier);
+            Y3[Column] = ScaledY * 4.0f * (1.0f - ScaleModifier);
+            XS[Column] = WorldX * 0.1f + Seed * 0.01f;
+            YS[Column] = WorldY * 0.1f;
+        }
+    }
+
+    float* Noise1 = Noise.GetData();
+    float* Noise2 = Noise1 + NumColumns;
+    float* Noise3 = Noise2 + NumColumns;
+    float* Secondary = Noise3 + NumColumns;
+
+    FTerrainNoise::Perlin2DBatch(X1, Y1, Noise1, NumColumns);
+    FTerrainNoise::Perlin2DBatch(X2, Y2, Noise2, NumColumns);
+    FTerrainNoise::Perlin2DBatch(X3, Y3, Noise3, NumColumns);
+    FTerrainNoise::Perlin2DBatch(XS, YS, Secondary, NumColumns);
+
+    for (int32 X = 0; X < ChunkSize; X++)
+    {
+        for (int32 Y = 0; Y < ChunkSize; Y++)
+        {
+            const int32 Column = X * ChunkSize + Y;
+            const float PerlinNoise = CombineNoiseOctaves(Noise1[Column], Noise2[Column] * 0.5f, Noise3[Column] * 0.25f);
+            OutHeights[Column] = ComposeTerrainHeight(ChunkCoord.X * ChunkSize + X, ChunkCoord.Y * ChunkSize + Y,
+                ChunkSeedModifier, PerlinNoise, Secondary[Column]);
+        }
+    }
+}
+
+// *** NEW: WORLD STATISTICS ***
+
+void ARandomMapGenerator::GatherWorldStatistics(FWorldGenerationStats& OutStats) const
+{
+    OutStats = FWorldGenerationStats();
+    OutStats.NumChunks = ChunksInfo.Num();
+    OutStats.BlockDataBytes = ChunksInfo.GetAllocatedSize();
+
+    // Hash chunk sırasından bağımsız olsun (TMap sırası ekleme sırasına bağlı)
+    TArray<FChunkCoord> ChunkCoords;
+    ChunksInfo.GetKeys(ChunkCoords);
+    ChunkCoords.Sort([](const FChunkCoord& A, const FChunkCoord& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+
+    TArray<uint8> ChunkTypes;
+    uint64 ContentHash = 0;
+
+    for (const FChunkCoord& ChunkCoord : ChunkCoords)
+    {
+        const FChunkInfo& ChunkInfo = ChunksInfo[ChunkCoord];
+        const FChunkBlockStorage& Blocks = ChunkInfo.Blocks;
+
+        if (ChunkInfo.bIsGenerated)
+        {
+            OutStats.NumGeneratedChunks++;
+        }
+
+        OutStats.BlockDataBytes += Blocks.GetAllocatedSize() +
+            ChunkInfo.TerrainHeights.GetAllocatedSize() + ChunkInfo.SurfaceHeights.GetAllocatedSize();
+
+        // Palette düzeni değil içerik hash'lenir
+        ChunkTypes.SetNumUninitialized(Blocks.GetNumBlocks() + 2 * sizeof(int32));
+        FMemory::Memcpy(ChunkTypes.GetData(), &ChunkCoord.X, sizeof(int32));
+        FMemory::Memcpy(ChunkTypes.GetData() + sizeof(int32), &ChunkCoord.Y, sizeof(int32));
+        for (int32 BlockIndex = 0; BlockIndex < Blocks.GetNumBlocks(); BlockIndex++)
+        {
+            const uint8 TypeValue = static_cast<uint8>(Blocks.GetBlockByIndex(BlockIndex));
+            ChunkTypes[2 * sizeof(int32) + BlockIndex] = TypeValue;
+            OutStats.BlockCounts[TypeValue & 15]++;
+        }
+        ContentHash = CityHash64WithSeed(reinterpret_cast<const char*>(ChunkTypes.GetData()), ChunkTypes.Num(), ContentHash);
+
+        int32 ChunkInstances = 0;
+        if (const FChunkISMData* ChunkData = ChunkISMSystem.Find(ChunkCoord))
+        {
+            for (const auto& CountPair : ChunkData->InstanceCounts)
+            {
+                ChunkInstances += CountPair.Value;
+            }
+        }
+        OutStats.InstancesPerChunk.Add(FIntPoint(ChunkCoord.X, ChunkCoord.Y), ChunkInstances);
+        OutStats.TotalInstances += ChunkInstances;
+
+        const FChunk* MeshChunk = Chunks.Find(FIntPoint(ChunkCoord.X, ChunkCoord.Y));
+        if (MeshChunk && MeshChunk->Mesh)
+        {
+            for (int32 SectionIndex = 0; SectionIndex < MeshChunk->Mesh->GetNumSections(); SectionIndex++)
+            {
+                if (FProcMeshSection* Section = MeshChunk->Mesh->GetProcMeshSection(SectionIndex))
+                {
+                    OutStats.MergedMeshTriangles += Section->ProcIndexBuffer.Num() / 3;
+                }
+            }
+        }
+    }
+
+    OutStats.ContentHash = ContentHash;
+}
+
+// *** NEW: CHUNK CONTENT HASHES ***
+// Server her chunk'ın içerik hash'ini replicate eder; client uyuşmayan chunk'ları UBuildSystem üzerinden server'dan ister.
+
+uint32 ARandomMapGenerator::GetBlockHashTerm(int32 BlockIndex, EBlockType BlockType)
+{
+    if (BlockType == EBlockType::Air)
+        return 0;
+
+    // (index, tip) çifti birebir, finalizer da birebir - farklı bloklar farklı terim verir
+    uint32 Value = (static_cast<uint32>(BlockIndex) << 4) | (static_cast<uint8>(BlockType) & 15);
+    Value ^= Value >> 16;
+    Value *= 0x85ebca6bU;
+    Value ^= Value >> 13;
+    Value *= 0xc2b2ae35U;
+    Value ^= Value >> 16;
+    return Value;
+}
+
+uint32 ARandomMapGenerator::ComputeChunkContentHash(const FChunkBlockStorage& Blocks)
+{
+    if (!Blocks.IsInitialized() || (Blocks.IsUniform() && Blocks.GetBlockByIndex(0) == EBlockType::Air))
+        return 0;
+
+    uint32 Hash = 0;
+    for (int32 BlockIndex = 0; BlockIndex < Blocks.GetNumBlocks(); BlockIndex++)
+    {
+        Hash ^= GetBlockHashTerm(BlockIndex, Blocks.GetBlockByIndex(BlockIndex));
+    }
+    return Hash;
+}
+
+void ARandomMapGenerator::MarkChunkHashDirty(const FChunkCoord& ChunkCoord)
+{
+    // Sadece server yayınlar
+    if (HasAuthority())
+    {
+        DirtyChunkHashes.Add(ChunkCoord);
+    }
+}
+
+void ARandomMapGenerator::PublishChunkHashes(bool bFull)
+{
+    if (bFull)
+    {
+        ChunkHashes.Reset();
+        ChunkHashIndices.Reset();
+
+        TArray<FChunkCoord> ChunkCoords;
+        ChunksInfo.GetKeys(ChunkCoords);
+        ChunkCoords.Sort([](const FChunkCoord& A, const FChunkCoord& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+        DirtyChunkHashes.Reset();
+        DirtyChunkHashes.Append(ChunkCoords);
+    }
+
+    // Değişen elemanlar replicate olur - edit başına tek hash.
+    // Dağ sınırı chunk'ları düzenlenemez ve client'lar onları karşılaştırmaz - yayınlanmaz
+    for (const FChunkCoord& ChunkCoord : DirtyChunkHashes)
+    {
+        const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+        if (!ChunkInfo || !IsChunkInsideMap(ChunkCoord))
+            continue;
+
+        const FIntPoint ChunkKey(ChunkCoord.X, ChunkCoord.Y);
+        if (const int32* Index = ChunkHashIndices.Find(ChunkKey))
+        {
+            ChunkHashes[*Index].Hash = ChunkInfo->ContentHash;
+        }
+        else
+        {
+            FChunkContentHash Entry;
+            Entry.ChunkCoord = ChunkKey;
+            Entry.Hash = ChunkInfo->ContentHash;
+            ChunkHashIndices.Add(ChunkKey, ChunkHashes.Add(Entry));
+        }
+    }
+
+    DirtyChunkHashes.Reset();
+}
+
+void ARandomMapGenerator::OnRep_ChunkHashes()
+{
+    if (bHasGeneratedWorld && !bIsGeneratingWorld)
+    {
+        ScheduleChunkHashVerification();
+    }
+}
+
+void ARandomMapGenerator::ScheduleChunkHashVerification()
+{
+    // Bekleyen bir kontrol varsa ertelenmez (sürekli edit altında da kontrol yapılır)
+    if (!HasAuthority() && ChunkHashVerifyTime <= 0.0)
+    {
+        ChunkHashVerifyTime = GetWorld()->GetTimeSeconds() + FMath::Max(ChunkHashVerifyDelay, 0.01f);
+    }
+}
+
+void ARandomMapGenerator::VerifyChunkHashes()
+{
+    ChunkHashVerifyTime = 0.0;
+
+    if (HasAuthority() || !bHasGeneratedWorld || bIsGeneratingWorld)
+        return;
+
+    // Journal uygulanınca yeniden planlanır
+    if (bAwaitingEditJournal)
+        return;
+
+    UBuildSystem* BuildSystem = nullptr;
+    TMap<FIntPoint, uint32> StillSuspect;
+
+    // Chunk relevancy: uzak chunk'ların edit'leri bilerek gelmez - sadece ilgi yarıçapının içi (1 chunk pay ile) karşılaştırılır
+    bool bHasViewChunk = false;
+    FChunkCoord ViewChunk(0, 0);
+    const bool bRelevancyFiltered = bChunkRelevancy && !bReplicateBlockEditsAsFastArray;
+    if (bRelevancyFiltered)
+    {
+        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+        {
+            APlayerController* PlayerController = It->Get();
+            if (PlayerController && PlayerController->IsLocalController() && PlayerController->GetViewTarget())
+            {
+                ViewChunk = WorldToChunkCoord(PlayerController->GetViewTarget()->GetActorLocation());
+                bHasViewChunk = true;
+                break;
+            }
+        }
+    }
+    int32 NumMismatched = 0;
+    int32 NumRequested = 0;
+
+    // Server cevapsız bıraktıysa (bütçe, relevancy) istek zaman aşımıyla düşer ve chunk tekrar karşılaştırılır
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (auto It = RequestedChunkResyncs.CreateIterator(); It; ++It)
+    {
+        if (Now - It->Value > FMath::Max(ChunkResyncTimeout, ChunkHashVerifyDelay))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    for (const FChunkContentHash& Entry : ChunkHashes)
+    {
+        const FChunkCoord ChunkCoord(Entry.ChunkCoord.X, Entry.ChunkCoord.Y);
+
+        // Client'ta olmayan chunk'lar (streaming) karşılaştırılamaz
+        const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+        if (!ChunkInfo || RequestedChunkResyncs.Contains(Entry.ChunkCoord))
+            continue;
+
+        // Streaming client kenar dağlarını henüz üretmediyse kenar chunk'ları zaten farklı
+        const bool bInnerChunk = ChunkCoord.X > 0 && ChunkCoord.Y > 0 &&
+            ChunkCoord.X < WorldSizeInChunks - 1 && ChunkCoord.Y < WorldSizeInChunks - 1;
+        if (bStreamWorld && GeneratedEdgeFeatures != 0xF && !bInnerChunk)
+            continue;
+
+        // Dağ sınırı chunk'ları düzenlenemez ve server resync isteğini reddeder
+        if (!IsChunkInsideMap(ChunkCoord))
+            continue;
+
+        if (bRelevancyFiltered && (!bHasViewChunk ||
+            FVector2D(Entry.ChunkCoord.X - ViewChunk.X, Entry.ChunkCoord.Y - ViewChunk.Y).Size() > ChunkRelevancyRadius - 1.f))
+            continue;
+
+        if (ChunkInfo->ContentHash == Entry.Hash)
+            continue;
+
+        NumMismatched++;
+
+        // İlk uyuşmazlıkta edit hâlâ yolda olabilir - aynı server hash'iyle ikinci kez uyuşmazsa resync
+        const uint32* PreviousHash = SuspectChunkHashes.Find(Entry.ChunkCoord);
+        if (!PreviousHash || *PreviousHash != Entry.Hash || NumRequested >= MaxChunkResyncsPerCheck)
+        {
+            StillSuspect.Add(Entry.ChunkCoord, Entry.Hash);
+            continue;
+        }
+
+        if (!BuildSystem)
+        {
+            BuildSystem = GetLocalBuildSystem();
+        }
+        if (!BuildSystem)
+        {
+            StillSuspect.Add(Entry.ChunkCoord, Entry.Hash);
+            continue;
+        }
+
+        BuildSystem->ServerRequestChunkResync(Entry.ChunkCoord);
+        RequestedChunkResyncs.Add(Entry.ChunkCoord, Now);
+        NumRequested++;
+    }
+
+    SuspectChunkHashes = MoveTemp(StillSuspect);
+    if (SuspectChunkHashes.Num() > 0 || RequestedChunkResyncs.Num() > 0)
+    {
+        ScheduleChunkHashVerification();
+    }
+
+    if (NumMismatched > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CLIENT: %d of %d chunks differ from the server, %d resync requested (%d total)"),
+            NumMismatched, ChunkHashes.Num(), NumRequested, NumChunkResyncs + RequestedChunkResyncs.Num());
+    }
+}
+
+UBuildSystem* ARandomMapGenerator::GetLocalBuildSystem() const
+{
+    // Server RPC'leri client'ın sahip olduğu bir actor üzerinden gitmeli - generator server'ın
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController())
+        {
+            if (UBuildSystem* BuildSystem = GetBuildSystemForController(PlayerController))
+                return BuildSystem;
+        }
+    }
+
+    return nullptr;
+}
+
+APlayerController* ARandomMapGenerator::GetControllerForBuildSystem(UBuildSystem* BuildSystem)
+{
+    AActor* Owner = BuildSystem ? BuildSystem->GetOwner() : nullptr;
+    if (APlayerController* PlayerController = Cast<APlayerController>(Owner))
+        return PlayerController;
+
+    APawn* Pawn = Cast<APawn>(Owner);
+    return Pawn ? Cast<APlayerController>(Pawn->GetController()) : nullptr;
+}
+
+UBuildSystem* ARandomMapGenerator::GetBuildSystemForController(APlayerController* PlayerController)
+{
+    if (!PlayerController)
+        return nullptr;
+
+    if (APawn* Pawn = PlayerController->GetPawn())
+    {
+        if (UBuildSystem* BuildSystem = Pawn->FindComponentByClass<UBuildSystem>())
+            return BuildSystem;
+    }
+
+    return PlayerController->FindComponentByClass<UBuildSystem>();
+}
+
+// *** NEW: CHUNK RELEVANCY ***
+// Generator her bağlantıya replicate olmaya devam eder (seed, hash'ler, base core), ama blok edit ve hasar
+// trafiği sadece view target'ı chunk'a yakın bağlantılara gider. Uzaktaki edit'ler chunk sürümü olarak
+// bekler; bağlantı chunk'a yaklaşınca o chunk'ın tüm edit'leri tek delta olarak gönderilir.
+
+bool ARandomMapGenerator::IsChunkInRelevancyRadius(const FChunkCoord& CenterChunk, const FIntPoint& ChunkCoord) const
+{
+    const float DeltaX = ChunkCoord.X - CenterChunk.X;
+    const float DeltaY = ChunkCoord.Y - CenterChunk.Y;
+    return DeltaX * DeltaX + DeltaY * DeltaY <= ChunkRelevancyRadius * ChunkRelevancyRadius;
+}
+
+void ARandomMapGenerator::UpdateChunkSubscriptions()
+{
+    // Ayrılan oyuncular
+    for (auto It = ChunkSubscribers.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    const int32 RadiusInChunks = FMath::CeilToInt(ChunkRelevancyRadius);
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        // Listen server'ın kendi oyuncusu server verisini zaten görüyor
+        APlayerController* PlayerController = It->Get();
+        if (!PlayerController || PlayerController->IsLocalController())
+            continue;
+
+        // Pawn değiştiyse (respawn) RPC'ler yeni component'e gider; arada kaçanlar için tüm chunk'lar yeniden değerlendirilir
+        FChunkSubscriber& Subscriber = ChunkSubscribers.FindOrAdd(PlayerController);
+        UBuildSystem* BuildSystem = GetBuildSystemForController(PlayerController);
+        if (BuildSystem != Subscriber.BuildSystem.Get())
+        {
+            Subscriber.BuildSystem = BuildSystem;
+            Subscriber.SubscribedChunks.Reset();
+        }
+
+        AActor* ViewTarget = PlayerController->GetViewTarget();
+        if (!BuildSystem || !ViewTarget)
+            continue;
+
+        const FChunkCoord CenterChunk = WorldToChunkCoord(ViewTarget->GetActorLocation());
+
+        TSet<FIntPoint> NewSubscribedChunks;
+        NewSubscribedChunks.Reserve((RadiusInChunks * 2 + 1) * (RadiusInChunks * 2 + 1));
+        for (int32 OffsetX = -RadiusInChunks; OffsetX <= RadiusInChunks; OffsetX++)
+        {
+            for (int32 OffsetY = -RadiusInChunks; OffsetY <= RadiusInChunks; OffsetY++)
+            {
+                const FIntPoint ChunkCoord(CenterChunk.X + OffsetX, CenterChunk.Y + OffsetY);
+                if (!IsChunkInRelevancyRadius(CenterChunk, ChunkCoord))
+                    continue;
+
+                NewSubscribedChunks.Add(ChunkCoord);
+
+                // Uzaktayken kaçırılan edit'ler
+                if (!Subscriber.SubscribedChunks.Contains(ChunkCoord))
+                {
+                    const uint32* Version = ChunkEditVersions.Find(ChunkCoord);
+                    if (Version && Subscriber.KnownVersions.FindRef(ChunkCoord) != *Version)
+                    {
+                        SendChunkCatchUp(Subscriber, ChunkCoord);
+                    }
+                }
+            }
+        }
+
+        Subscriber.SubscribedChunks = MoveTemp(NewSubscribedChunks);
+    }
+}
+
+void ARandomMapGenerator::SendChunkCatchUp(FChunkSubscriber& Subscriber, const FIntPoint& ChunkCoord)
+{
+    UBuildSystem* BuildSystem = Subscriber.BuildSystem.Get();
+    if (!BuildSystem)
+        return;
+
+    // Çok düzenlenmiş chunk: blok listesi yerine server'daki hali
+    if (SnapshotEditChunks.Contains(ChunkCoord))
+    {
+        TArray<uint8> BlockData;
+        if (GetChunkResyncData(ChunkCoord, BlockData))
+        {
+            BuildSystem->ClientReceiveChunkResync(ChunkCoord, BlockData);
+            Subscriber.KnownVersions.Add(ChunkCoord, ChunkEditVersions.FindRef(ChunkCoord));
+        }
+        return;
+    }
+
+    const TMap<int32, EBlockType>* Edits = ChunkEdits.Find(ChunkCoord);
+    if (!Edits)
+        return;
+
+    // Client'ta zaten olan değişiklikler atlanır (aynı tip), bu yüzden tüm edit listesi güvenle tekrar gönderilir
+    FChunkBlockDelta Delta;
+    Delta.ChunkCoord = ChunkCoord;
+    Delta.Changes.Reserve(FMath::Min(Edits->Num(), MaxBlockDeltaChangesPerRPC));
+
+    for (const auto& EditPair : *Edits)
+    {
+        Delta.Changes.Add((static_cast<uint32>(EditPair.Key) << 4) | (static_cast<uint8>(EditPair.Value) & 15));
+        if (Delta.Changes.Num() == MaxBlockDeltaChangesPerRPC)
+        {
+            BuildSystem->ClientApplyBlockDelta(Delta);
+            Delta.Changes.Reset();
+        }
+    }
+
+    if (Delta.Changes.Num() > 0)
+    {
+        BuildSystem->ClientApplyBlockDelta(Delta);
+    }
+
+    Subscriber.KnownVersions.Add(ChunkCoord, ChunkEditVersions.FindRef(ChunkCoord));
+}
+
+// *** NEW: LATE JOIN EDIT JOURNAL ***
+// Geç katılan client dünyayı seed'den üretir; ondan önceki edit'ler (ChunkEdits) sıkıştırılıp parçalar halinde,
+// client onayladıkça ve saniye başına bütçe içinde gönderilir - oyun trafiği reliable buffer'da sıkışmaz.
+// Format: int32 NumChunks, chunk başına FIntPoint + int32 NumChanges + (local index << 4 | type) listesi.
+// Çok düzenlenmiş chunk'larda NumChanges = -1, ardından int32 boy + FChunkBlockStorage verisi (chunk resync ile aynı).
+
+void ARandomMapGenerator::BeginEditJournalStream(UBuildSystem* BuildSystem)
+{
+    // Fast array modunda geç katılanlar tüm edit listesini replicate edilen property'den alır
+    APlayerController* PlayerController = GetControllerForBuildSystem(BuildSystem);
+    if (!HasAuthority() || !PlayerController || bReplicateBlockEditsAsFastArray)
+        return;
+
+    // Bağlantı başına dünya üretimi başına bir journal: tamamlandıysa tekrar gönderilmez
+    if (CompletedEditJournals.Contains(PlayerController))
+        return;
+
+    // Yarım kalmış akış (pawn değişti / parçalar kayboldu): aynı snapshot baştan, yeni component üzerinden.
+    // Snapshot'tan sonraki edit'ler client'ta ertelenmiş canlı delta'lar olarak bekliyor.
+    for (FEditJournalStream& Stream : EditJournalStreams)
+    {
+        if (Stream.PlayerController.Get() == PlayerController)
+        {
+            Stream.BuildSystem = BuildSystem;
+            Stream.NextPart = 0;
+            Stream.AckedParts = 0;
+            return;
+        }
+    }
+
+    TArray<uint8> JournalData;
+    FMemoryWriter Ar(JournalData);
+
+    int32 NumChunks = ChunkEdits.Num() + SnapshotEditChunks.Num();
+    Ar << NumChunks;
+    for (const FIntPoint& SnapshotChunk : SnapshotEditChunks)
+    {
+        TArray<uint8> BlockData;
+        GetChunkResyncData(SnapshotChunk, BlockData);
+
+        FIntPoint ChunkCoord = SnapshotChunk;
+        int32 NumChanges = -1;
+        int32 DataSize = BlockData.Num();
+        Ar << ChunkCoord.X << ChunkCoord.Y << NumChanges << DataSize;
+        Ar.Serialize(BlockData.GetData(), DataSize);
+    }
+    for (const auto& ChunkPair : ChunkEdits)
+    {
+        FIntPoint ChunkCoord = ChunkPair.Key;
+        int32 NumChanges = ChunkPair.Value.Num();
+        Ar << ChunkCoord.X << ChunkCoord.Y << NumChanges;
+
+        for (const auto& EditPair : ChunkPair.Value)
+        {
+            uint32 Change = (static_cast<uint32>(EditPair.Key) << 4) | (static_cast<uint8>(EditPair.Value) & 15);
+            Ar << Change;
+        }
+    }
+
+    FEditJournalStream& Stream = EditJournalStreams.AddDefaulted_GetRef();
+    Stream.PlayerController = PlayerController;
+    Stream.BuildSystem = BuildSystem;
+    Stream.UncompressedSize = JournalData.Num();
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, JournalData.Num());
+    Stream.CompressedData.SetNumUninitialized(CompressedSize);
+    if (FCompression::CompressMemory(NAME_Zlib, Stream.CompressedData.GetData(), CompressedSize, JournalData.GetData(), JournalData.Num()))
+    {
+        Stream.CompressedData.SetNum(CompressedSize);
+    }
+    else
+    {
+        // Sıkıştırılamadıysa ham gönderilir; negatif UncompressedSize = -ham veri boyu
+        Stream.CompressedData = JournalData;
+        Stream.UncompressedSize = -JournalData.Num();
+    }
+
+    const int32 PartSize = FMath::Max(EditJournalPartSize, 1024);
+    Stream.NumParts = FMath::Max(1, (Stream.CompressedData.Num() + PartSize - 1) / PartSize);
+
+    // Journal chunk relevancy catch-up'larını da kapsar
+    if (FChunkSubscriber* Subscriber = ChunkSubscribers.Find(PlayerController))
+    {
+        Subscriber->KnownVersions = ChunkEditVersions;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("SERVER: Edit journal for late join - %d chunks, %d bytes, %d compressed, %d parts"),
+        NumChunks, JournalData.Num(), Stream.CompressedData.Num(), Stream.NumParts);
+}
+
+void ARandomMapGenerator::PumpEditJournalStreams(float DeltaTime)
+{
+    const int32 PartSize = FMath::Max(EditJournalPartSize, 1024);
+
+    // Bütçe frame'ler arasında birikir (en fazla bir pencere kadar), parça boyu frame bütçesinden büyük olabilir
+    const float MaxBudget = static_cast<float>(PartSize) * FMath::Max(EditJournalWindowParts, 1);
+    EditJournalByteBudget = FMath::Min(EditJournalByteBudget + EditJournalBytesPerSecond * DeltaTime, MaxBudget);
+
+    for (int32 StreamIndex = EditJournalStreams.Num() - 1; StreamIndex >= 0; StreamIndex--)
+    {
+        FEditJournalStream& Stream = EditJournalStreams[StreamIndex];
+        if (!Stream.PlayerController.IsValid())
+        {
+            EditJournalStreams.RemoveAtSwap(StreamIndex);
+        }
+        else if (Stream.AckedParts >= Stream.NumParts)
+        {
+            CompletedEditJournals.Add(Stream.PlayerController);
+            EditJournalStreams.RemoveAtSwap(StreamIndex);
+        }
+    }
+
+    const int32 NumStreams = EditJournalStreams.Num();
+    if (NumStreams == 0)
+        return;
+
+    // Akışlar bütçeyi parça parça sırayla paylaşır; ilk sıradaki akış her frame kayar (biri diğerlerini aç bırakmaz)
+    EditJournalPumpStart = (EditJournalPumpStart + 1) % NumStreams;
+
+    bool bSentPart = true;
+    while (bSentPart)
+    {
+        bSentPart = false;
+        for (int32 Offset = 0; Offset < NumStreams; Offset++)
+        {
+            FEditJournalStream& Stream = EditJournalStreams[(EditJournalPumpStart + Offset) % NumStreams];
+
+            // Component öldüyse client yenisiyle tekrar ister - o zamana kadar bekle.
+            // Pencere dolunca client'ın onayı beklenir
+            UBuildSystem* BuildSystem = Stream.BuildSystem.Get();
+            if (!BuildSystem || Stream.NextPart >= Stream.NumParts ||
+                Stream.NextPart - Stream.AckedParts >= FMath::Max(EditJournalWindowParts, 1))
+                continue;
+
+            // Bu parça bütçeye sığmıyorsa diğer akışların (son, küçük) parçaları yine gidebilir
+            const int32 DataOffset = Stream.NextPart * PartSize;
+            const int32 Size = FMath::Min(PartSize, Stream.CompressedData.Num() - DataOffset);
+            if (EditJournalByteBudget < Size)
+                continue;
+
+            TArray<uint8> PartData;
+            PartData.Append(Stream.CompressedData.GetData() + DataOffset, FMath::Max(Size, 0));
+            BuildSystem->ClientReceiveEditJournalPart(Stream.NextPart, Stream.NumParts, Stream.UncompressedSize, PartData);
+
+            EditJournalByteBudget -= Size;
+            Stream.NextPart++;
+            bSentPart = true;
+        }
+    }
+}
+
+void ARandomMapGenerator::AckEditJournalPart(const UBuildSystem* BuildSystem, int32 PartIndex)
+{
+    for (FEditJournalStream& Stream : EditJournalStreams)
+    {
+        if (Stream.BuildSystem.Get() == BuildSystem)
+        {
+            Stream.AckedParts = FMath::Clamp(FMath::Max(Stream.AckedParts, PartIndex + 1), 0, Stream.NextPart);
+            return;
+        }
+    }
+}
+
+void ARandomMapGenerator::ReceiveEditJournalPart(int32 PartIndex, int32 NumParts, int32 UncompressedSize, const TArray<uint8>& Data)
+{
+    if (HasAuthority() || !bAwaitingEditJournal)
+        return;
+
+    EditJournalActivityTime = GetWorld()->GetTimeSeconds();
+
+    if (PartIndex == 0)
+    {
+        ReceivedEditJournal.Reset();
+        ReceivedEditJournalParts = 0;
+    }
+
+    // Reliable RPC'ler sıralı gelir - uymayan parça eski bir akıştan
+    if (PartIndex != ReceivedEditJournalParts)
+        return;
+
+    ReceivedEditJournal.Append(Data);
+    ReceivedEditJournalParts++;
+
+    if (ReceivedEditJournalParts < NumParts)
+        return;
+
+    // Son parça: aç ve uygula
+    TArray<uint8> JournalData;
+    bool bValid = true;
+    if (UncompressedSize >= 0)
+    {
+        // 64 MB üstü bozuk veri sayılır
+        bValid = UncompressedSize <= 64 * 1024 * 1024;
+        if (bValid)
+        {
+            JournalData.SetNumUninitialized(UncompressedSize);
+            bValid = FCompression::UncompressMemory(NAME_Zlib, JournalData.GetData(), UncompressedSize,
+                ReceivedEditJournal.GetData(), ReceivedEditJournal.Num());
+        }
+    }
+    else
+    {
+        // Ham journal: boyu işaretle aynı olmalı
+        bValid = ReceivedEditJournal.Num() == -UncompressedSize;
+        JournalData = MoveTemp(ReceivedEditJournal);
+    }
+
+    ReceivedEditJournal.Empty();
+    ReceivedEditJournalParts = 0;
+
+    // Bayrak önce kalkar: journal delta'ları ertelenmeden uygulanmalı (yoksa ertelenen daha yeni delta'ların arkasına düşer)
+    bAwaitingEditJournal = false;
+
+    if (bValid)
+    {
+        ApplyEditJournal(JournalData);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("CLIENT: Edit journal could not be decompressed - chunk hash check will resync edited chunks"));
+    }
+
+    // Journal sırasında gelen canlı delta'lar (journal'dan yeni) sırayla
+    TArray<FChunkBlockDelta> Deferred = MoveTemp(DeferredBlockDeltas);
+    DeferredBlockDeltas.Reset();
+    for (const FChunkBlockDelta& Delta : Deferred)
+    {
+        ApplyBlockDelta(Delta);
+    }
+
+    // Üretilen dünyayı server'ın chunk hash'leriyle karşılaştır
+    ScheduleChunkHashVerification();
+}
+
+void ARandomMapGenerator::ApplyEditJournal(const TArray<uint8>& JournalData)
+{
+    FMemoryReader Ar(JournalData);
+
+    int32 NumChunks = 0;
+    Ar << NumChunks;
+
+    int32 NumChanges = 0;
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks && !Ar.IsError(); ChunkIndex++)
+    {
+        FChunkBlockDelta Delta;
+        int32 NumChunkChanges = 0;
+        Ar << Delta.ChunkCoord.X << Delta.ChunkCoord.Y << NumChunkChanges;
+
+        // Chunk'ın tamamı
+        if (NumChunkChanges == -1)
+        {
+            int32 DataSize = 0;
+            Ar << DataSize;
+            if (Ar.IsError() || DataSize < 0 || DataSize > Ar.TotalSize() - Ar.Tell())
+                break;
+
+            TArray<uint8> BlockData;
+            BlockData.SetNumUninitialized(DataSize);
+            Ar.Serialize(BlockData.GetData(), DataSize);
+            ApplyChunkResync(Delta.ChunkCoord, BlockData);
+            continue;
+        }
+
+        // Bozuk sayılar okunan veriden büyük olamaz
+        if (NumChunkChanges < 0 || NumChunkChanges > (Ar.TotalSize() - Ar.Tell()) / 4)
+            break;
+
+        Delta.Changes.SetNumUninitialized(NumChunkChanges);
+        for (uint32& Change : Delta.Changes)
+        {
+            Ar << Change;
+        }
+
+        // Chunk başına tek delta - tek ISM güncellemesi
+        ApplyBlockDelta(Delta);
+        NumChanges += NumChunkChanges;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("CLIENT: Edit journal applied - %d chunks, %d block changes, %d bytes"),
+        NumChunks, NumChanges, JournalData.Num());
+}
+
+// *** NEW: FAST ARRAY BLOCK EDITS ***
+// Değişen bloklar replicate edilen bir FFastArraySerializer'da durur: Unreal sadece değişen item'ları gönderir,
+// kaybolan paketleri tekrar gönderir ve geç katılanlara tüm listeyi verir. Client callback'leri
+// chunk başına toplanıp tek delta (tek ISM güncellemesi) olarak uygulanır.
+
+static uint64 PackBlockEditKey(const FIntPoint& ChunkCoord, int32 BlockIndex)
+{
+    return (static_cast<uint64>(static_cast<uint16>(ChunkCoord.X)) << 48) |
+        (static_cast<uint64>(static_cast<uint16>(ChunkCoord.Y)) << 32) |
+        static_cast<uint32>(BlockIndex);
+}
+
+static void UnpackBlockEditKey(uint64 BlockKey, FIntPoint& OutChunkCoord, int32& OutBlockIndex)
+{
+    OutChunkCoord.X = static_cast<int16>(BlockKey >> 48);
+    OutChunkCoord.Y = static_cast<int16>((BlockKey >> 32) & 0xFFFF);
+    OutBlockIndex = static_cast<int32>(BlockKey & 0xFFFFFFFF);
+}
+
+void FReplicatedBlockEdit::PostReplicatedAdd(const FReplicatedBlockEditArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->QueueReplicatedBlockEdit(*this);
+    }
+}
+
+void FReplicatedBlockEdit::PostReplicatedChange(const FReplicatedBlockEditArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->QueueReplicatedBlockEdit(*this);
+    }
+}
+
+void ARandomMapGenerator::SetReplicatedBlockEdit(const FIntPoint& ChunkCoord, int32 BlockIndex, EBlockType BlockType, uint8 Health, bool bKeepType)
+{
+    const uint64 BlockKey = PackBlockEditKey(ChunkCoord, BlockIndex);
+
+    FReplicatedBlockEdit* Edit = nullptr;
+    if (const int32* ItemIndex = ReplicatedBlockEditIndices.Find(BlockKey))
+    {
+        Edit = &ReplicatedBlockEdits.Items[*ItemIndex];
+    }
+    else
+    {
+        // Sadece hasar almış, hiç değişmemiş blok: tipi dünyadan
+        if (bKeepType)
+        {
+            const FBlockPosition BlockPos(BlockIndex / (ChunkSize * ChunkHeight), (BlockIndex / ChunkHeight) % ChunkSize, BlockIndex % ChunkHeight);
+            BlockType = GetBlockInternal(FChunkCoord(ChunkCoord.X, ChunkCoord.Y), BlockPos);
+        }
+
+        const int32 ItemIndex = ReplicatedBlockEdits.Items.AddDefaulted();
+        ReplicatedBlockEditIndices.Add(BlockKey, ItemIndex);
+        Edit = &ReplicatedBlockEdits.Items[ItemIndex];
+        Edit->BlockKey = BlockKey;
+        Edit->BlockType = static_cast<uint8>(BlockType);
+    }
+
+    if (!bKeepType)
+    {
+        Edit->BlockType = static_cast<uint8>(BlockType);
+    }
+    Edit->Health = Health;
+
+    ReplicatedBlockEdits.MarkItemDirty(*Edit);
+}
+
+void ARandomMapGenerator::QueueReplicatedBlockEdit(const FReplicatedBlockEdit& Edit)
+{
+    // Server kendi listesini yazıyor; client'ta aynı bloğun sadece son durumu uygulanır
+    if (!HasAuthority())
+    {
+        PendingReplicatedBlockEdits.Add(Edit.BlockKey, Edit);
+    }
+}
+
+void ARandomMapGenerator::ApplyReplicatedBlockEdits()
+{
+    TMap<FIntPoint, FChunkBlockDelta> Deltas;
+    TMap<FIntPoint, FChunkBlockDamageState> DamageStates;
+
+    for (const auto& EditPair : PendingReplicatedBlockEdits)
+    {
+        const FReplicatedBlockEdit& Edit = EditPair.Value;
+
+        FIntPoint ChunkCoord;
+        int32 BlockIndex = 0;
+        UnpackBlockEditKey(Edit.BlockKey, ChunkCoord, BlockIndex);
+
+        FChunkBlockDelta& Delta = Deltas.FindOrAdd(ChunkCoord);
+        Delta.ChunkCoord = ChunkCoord;
+        Delta.Changes.Add((static_cast<uint32>(BlockIndex) << 4) | (Edit.BlockType & 15));
+
+        if (Edit.Health > 0)
+        {
+            FChunkBlockDamageState& DamageState = DamageStates.FindOrAdd(ChunkCoord);
+            DamageState.ChunkCoord = ChunkCoord;
+            DamageState.Entries.Add((static_cast<uint32>(BlockIndex) << 8) | Edit.Health);
+        }
+    }
+    PendingReplicatedBlockEdits.Reset();
+
+    // Önce blok tipleri (değişen bloğun hasarı sıfırlanır), sonra güncel hasar
+    for (const auto& DeltaPair : Deltas)
+    {
+        ApplyBlockDelta(DeltaPair.Value);
+    }
+    for (const auto& DamagePair : DamageStates)
+    {
+        ApplyBlockDamageState(DamagePair.Value);
+    }
+}
+
+bool ARandomMapGenerator::IsChunkRelevantTo(const UBuildSystem* BuildSystem, const FIntPoint& ChunkCoord) const
+{
+    if (!bChunkRelevancy || bReplicateBlockEditsAsFastArray)
+        return true;
+
+    for (const auto& SubscriberPair : ChunkSubscribers)
+    {
+        if (SubscriberPair.Value.BuildSystem.Get() == BuildSystem)
+            return SubscriberPair.Value.SubscribedChunks.Contains(ChunkCoord);
+    }
+
+    return false;
+}
+
+bool ARandomMapGenerator::ConsumeChunkResyncBudget(UBuildSystem* BuildSystem)
+{
+    if (!HasAuthority() || !BuildSystem)
+        return false;
+
+    // Dürüst client kontrol başına en fazla MaxChunkResyncsPerCheck ister ve kontroller ChunkHashVerifyDelay aralıklı;
+    // pencereyi aşan istekler (döngüdeki değiştirilmiş client) serialize edilmeden düşer
+    if (ChunkResyncBudgets.Num() > 64)
+    {
+        for (auto It = ChunkResyncBudgets.CreateIterator(); It; ++It)
+        {
+            if (!It->Key.IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    FChunkResyncBudget& Budget = ChunkResyncBudgets.FindOrAdd(BuildSystem);
+    if (Now - Budget.WindowStart >= FMath::Max(ChunkHashVerifyDelay, 0.5f))
+    {
+        Budget.WindowStart = Now;
+        Budget.NumRequests = 0;
+    }
+
+    if (Budget.NumRequests >= FMath::Max(MaxChunkResyncsPerCheck, 1))
+        return false;
+
+    Budget.NumRequests++;
+    return true;
+}
+
+bool ARandomMapGenerator::GetChunkResyncData(const FIntPoint& ChunkCoord, TArray<uint8>& OutData)
+{
+    FChunkInfo* ChunkInfo = ChunksInfo.Find(FChunkCoord(ChunkCoord.X, ChunkCoord.Y));
+    if (!HasAuthority() || !ChunkInfo || !ChunkInfo->Blocks.IsInitialized())
+        return false;
+
+    // Palette + packed index'ler (en kötü 4 bit/blok)
+    FMemoryWriter Ar(OutData);
+    return ChunkInfo->Blocks.Serialize(Ar);
+}
+
+void ARandomMapGenerator::ApplyChunkResync(const FIntPoint& ChunkCoord, const TArray<uint8>& Data)
+{
+    RequestedChunkResyncs.Remove(ChunkCoord);
+
+    // Yerel dünya/journal hazır değilse üretim ya da daha eski journal bunu ezerdi; journal sonrası hash kontrolü chunk'ı tekrar ister
+    if (!bHasGeneratedWorld || bIsGeneratingWorld || bAwaitingEditJournal)
+    {
+        UE_LOG(LogTemp, Display, TEXT("CLIENT: Chunk (%d,%d) data arrived before the world was ready - left to the hash check"), ChunkCoord.X, ChunkCoord.Y);
+        return;
+    }
+
+    FChunkBlockStorage NewBlocks;
+    FMemoryReader Ar(Data);
+    if (HasAuthority() || !NewBlocks.Serialize(Ar) ||
+        NewBlocks.GetChunkSize() != ChunkSize || NewBlocks.GetChunkHeight() != ChunkHeight)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CLIENT: Invalid resync data for chunk (%d,%d)"), ChunkCoord.X, ChunkCoord.Y);
+        return;
+    }
+
+    const FChunkCoord Coord(ChunkCoord.X, ChunkCoord.Y);
+    // Server kopyası kenar özelliklerini zaten içerir; kenar sonradan üretilip üzerine yazmasın
+    EnsureEdgeFeaturesForChunk(Coord);
+    FChunkInfo& ChunkInfo = FindOrAddChunkInfo(Coord);
+    ChunkInfo.Blocks = MoveTemp(NewBlocks);
+    // Server kopyası - seed'den üretilen halinden farklı, streaming bırakmasın
+    ChunkInfo.bPinned = true;
+    RebuildSurfaceHeights(ChunkInfo);
+    ChunkInfo.ContentHash = ComputeChunkContentHash(ChunkInfo.Blocks);
+
+    SuspectChunkHashes.Remove(ChunkCoord);
+    NumChunkResyncs++;
+
+    RequestChunkBuild(Coord);
+    RequestNeighbourChunkBuilds(Coord);
+
+    UE_LOG(LogTemp, Warning, TEXT("CLIENT: Chunk (%d,%d) resynced from server (%d bytes, hash %08x)"),
+        ChunkCoord.X, ChunkCoord.Y, Data.Num(), ChunkInfo.ContentHash);
+}
+
+// *** NEW: GENERATED WORLD CACHE ***
+// Dosya: header (magic, versiyon, ayar hash'i) + chunk'lar (palette + packed index'ler, heightmap) + mağara konumları.
+
+static const uint32 WorldCacheMagic = 0x43574442; // "BDWC"
+static const int32 WorldCacheVersion = 2;
+
+uint64 ARandomMapGenerator::GetWorldCacheKey() const
+{
+    TArray<uint8> KeyBytes;
+    FMemoryWriter Ar(KeyBytes);
+    auto AddToKey = [&Ar](auto Value) { Ar << Value; };
+
+    AddToKey(WorldCacheVersion);
+
+    // Arazi ve ağaçlar
+    AddToKey(Seed);
+    AddToKey(WorldSizeInChunks);
+    AddToKey(ChunkSize);
+    AddToKey(ChunkHeight);
+    AddToKey(MapFlatness);
+    AddToKey(TreeDensity);
+    AddToKey(BaseHeight);
+    AddToKey(HeightVariation);
+    AddToKey(NoiseScale);
+
+    // Base core alanı (merkez düzlüğü ComposeTerrainHeight'ta)
+    AddToKey(BaseCoreSize);
+    AddToKey(BaseCoreCenter);
+
+    // Dağ kenarı
+    AddToKey(bCreateMountainBorders);
+    AddToKey(MountainBorderWidth);
+    AddToKey(MountainNoiseScale);
+    AddToKey(MountainMinHeight);
+    AddToKey(MountainMaxHeight);
+
+    // Mağaralar
+    AddToKey(CavesPerEdge);
+    AddToKey(CaveWidth);
+    AddToKey(CaveHeight);
+    AddToKey(CaveDepth);
+    AddToKey(CaveFloorVariation);
+    AddToKey(CaveHeightVariation);
+    AddToKey(CaveTunnelDeviation);
+    AddToKey(bNaturalCaveTunnels);
+    AddToKey(bCreateRockyFormations);
+    AddToKey(CaveRockyFormationRadius);
+    AddToKey(RockFormationDensity);
+    AddToKey(MaxExtraRockHeight);
+    AddToKey(bSealCaves);
+    AddToKey(CaveSpawnDepthRatio);
+
+    // CaveLocations dünya koordinatında saklanır
+    AddToKey(BlockSize);
+    AddToKey(BlockSpacing);
+
+    return CityHash64(reinterpret_cast<const char*>(KeyBytes.GetData()), KeyBytes.Num());
+}
+
+FString ARandomMapGenerator::GetWorldCacheFilePath() const
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), WorldCacheDirectory,
+        FString::Printf(TEXT("World_%016llx.bdwc"), GetWorldCacheKey()));
+}
+
+bool ARandomMapGenerator::LoadWorldCache()
+{
+    const FString FilePath = GetWorldCacheFilePath();
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*FilePath))
+    {
+        UE_LOG(LogTemp, Display, TEXT("World cache miss: %s"), *FilePath);
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Map edilen dosyadan okunur; packed index'ler doğrudan chunk storage'a kopyalanır (region handle'dan önce kapanır)
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+    TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+
+    TArray<uint8> FileBytes;
+    TArrayView<const uint8> FileView;
+    if (MappedRegion)
+    {
+        FileView = TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+    }
+    else if (FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+    {
+        // Platform memory mapping desteklemiyor
+        FileView = FileBytes;
+    }
+    else
+    {
+        return false;
+    }
+
+    FMemoryReaderView Ar(FileView);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    uint64 CacheKey = 0;
+    int32 NumChunks = 0;
+    Ar << Magic << Version << CacheKey << NumChunks;
+
+    if (Ar.IsError() || Magic != WorldCacheMagic || Version != WorldCacheVersion || CacheKey != GetWorldCacheKey() || NumChunks < 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("World cache %s is invalid or out of date - regenerating"), *FilePath);
+        return false;
+    }
+
+    bool bValid = true;
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks && bValid; ChunkIndex++)
+    {
+        int32 ChunkX = 0;
+        int32 ChunkY = 0;
+        uint8 Flags = 0;
+        Ar << ChunkX << ChunkY << Flags;
+
+        FChunkInfo& ChunkInfo = FindOrAddChunkInfo(FChunkCoord(ChunkX, ChunkY));
+        ChunkInfo.bIsGenerated = (Flags & 1) != 0;
+        ChunkInfo.bPinned = (Flags & 2) != 0;
+        ChunkInfo.TerrainHeights.BulkSerialize(Ar);
+
+        bValid = ChunkInfo.Blocks.Serialize(Ar) && !Ar.IsError() &&
+            ChunkInfo.Blocks.GetChunkSize() == ChunkSize && ChunkInfo.Blocks.GetChunkHeight() == ChunkHeight &&
+            (ChunkInfo.TerrainHeights.Num() == 0 || ChunkInfo.TerrainHeights.Num() == ChunkSize * ChunkSize);
+
+        if (bValid)
+        {
+            RebuildSurfaceHeights(ChunkInfo);
+            ChunkInfo.ContentHash = ComputeChunkContentHash(ChunkInfo.Blocks);
+        }
+    }
+
+    int32 NumCaves = 0;
+    Ar << NumCaves;
+
+    CaveLocations.Reset();
+    for (int32 CaveIndex = 0; CaveIndex < NumCaves && bValid && !Ar.IsError(); CaveIndex++)
+    {
+        FVector EntranceLocation;
+        FVector SpawnLocation;
+        int32 EdgeIndex = 0;
+        float EdgePosition = 0.0f;
+        Ar << EntranceLocation << SpawnLocation << EdgeIndex << EdgePosition;
+
+        CaveLocations.Add(FCaveLocation(EntranceLocation, SpawnLocation, EdgeIndex, EdgePosition));
+    }
+
+    if (!bValid || Ar.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("World cache %s is corrupt - regenerating"), *FilePath);
+        ChunksInfo.Empty();
+        CaveLocations.Empty();
+        return false;
+    }
+
+    bLoadedFromWorldCache = true;
+
+    UE_LOG(LogTemp, Warning, TEXT("World cache hit: %d chunks, %d caves loaded from %s in %.2f ms"),
+        NumChunks, CaveLocations.Num(), *FilePath, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return true;
+}
+
+void ARandomMapGenerator::SaveWorldCache()
+{
+    bSavedWorldCache = true;
+
+    TArray<uint8> FileBytes;
+    FMemoryWriter Ar(FileBytes);
+
+    uint32 Magic = WorldCacheMagic;
+    int32 Version = WorldCacheVersion;
+    uint64 CacheKey = GetWorldCacheKey();
+    int32 NumChunks = ChunksInfo.Num();
+    Ar << Magic << Version << CacheKey << NumChunks;
+
+    for (auto& ChunkPair : ChunksInfo)
+    {
+        FChunkInfo& ChunkInfo = ChunkPair.Value;
+
+        int32 ChunkX = ChunkPair.Key.X;
+        int32 ChunkY = ChunkPair.Key.Y;
+        uint8 Flags = (ChunkInfo.bIsGenerated ? 1 : 0) | (ChunkInfo.bPinned ? 2 : 0);
+        Ar << ChunkX << ChunkY << Flags;
+
+        ChunkInfo.TerrainHeights.BulkSerialize(Ar);
+        ChunkInfo.Blocks.Serialize(Ar);
+    }
+
+    int32 NumCaves = CaveLocations.Num();
+    Ar << NumCaves;
+
+    for (const FCaveLocation& Cave : CaveLocations)
+    {
+        FVector EntranceLocation = Cave.CaveEntranceLocation;
+        FVector SpawnLocation = Cave.CaveSpawnLocation;
+        int32 EdgeIndex = Cave.EdgeIndex;
+        float EdgePosition = Cave.EdgePosition;
+        Ar << EntranceLocation << SpawnLocation << EdgeIndex << EdgePosition;
+    }
+
+    // Disk yazımı game thread'i bekletmesin
+    const FString FilePath = GetWorldCacheFilePath();
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [FileBytes = MoveTemp(FileBytes), FilePath]()
+    {
+        // Yarım yazılmış dosya okunmasın diye önce geçici dosyaya
+        const FString TempPath = FilePath + TEXT(".tmp");
+        if (FFileHelper::SaveArrayToFile(FileBytes, *TempPath) && IFileManager::Get().Move(*FilePath, *TempPath))
+        {
+            UE_LOG(LogTemp, Display, TEXT("World cache saved: %s (%d KB)"), *FilePath, FileBytes.Num() / 1024);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("World cache could not be written: %s"), *FilePath);
+        }
+    });
+}
+
+// *** NEW: CROSS-CHUNK FEATURE WRITES ***
+// Ağaçlar komşu chunk'lara yazabilir: bloklar hedef chunk üretilmişse hemen, değilse üretildiğinde birleştirilir.
+
+void FFeatureWriter::SetBlock(int32 WorldX, int32 WorldY, int32 Z, EBlockType BlockType)
+{
+    // Negatif koordinatlar için floor bölme
+    const FIntPoint TargetChunk(FMath::FloorToInt(static_cast<float>(WorldX) / ChunkSize),
+        FMath::FloorToInt(static_cast<float>(WorldY) / ChunkSize));
+
+    int32 LocalX = WorldX % ChunkSize;
+    if (LocalX < 0) LocalX += ChunkSize;
+
+    int32 LocalY = WorldY % ChunkSize;
+    if (LocalY < 0) LocalY += ChunkSize;
+
+    if (!bCollectAllWrites && TargetChunk.X == ChunkCoord.X && TargetChunk.Y == ChunkCoord.Y)
+    {
+        ApplyBlock(Blocks, FIntVector(LocalX, LocalY, Z), BlockType);
+    }
+    else if (Z >= 0 && Z < Blocks.GetChunkHeight())
+    {
+        OutgoingWrites.FindOrAdd(TargetChunk).Add(FFeatureBlockWrite{ FIntVector(LocalX, LocalY, Z), BlockType });
+    }
+}
+
+bool FFeatureWriter::ApplyBlock(FChunkBlockStorage& Blocks, const FIntVector& LocalPos, EBlockType BlockType)
+{
+    if (!Blocks.IsValidPosition(LocalPos.X, LocalPos.Y, LocalPos.Z))
+        return false;
+
+    const EBlockType Existing = Blocks.GetBlock(LocalPos.X, LocalPos.Y, LocalPos.Z);
+    if (Existing != EBlockType::Air && !(Existing == EBlockType::Leaves && BlockType == EBlockType::Wood))
+        return false;
+
+    Blocks.SetBlock(LocalPos.X, LocalPos.Y, LocalPos.Z, BlockType);
+    return true;
+}
+
+bool ARandomMapGenerator::MergeFeatureWrites(FChunkInfo& ChunkInfo, const FFeatureWriteBatch& Batch)
+{
+    // Streaming'de kaynak chunk bırakılıp yeniden üretilirse aynı blokları tekrar gönderir.
+    // Kaynak chunk'ın tüm ağaçları hedef başına tek batch'tir (runtime ağaçlar buradan geçmez, edit olarak yazılır)
+    if (ChunkInfo.IncomingFeatureWrites.ContainsByPredicate([&Batch](const FFeatureWriteBatch& Merged) { return Merged.SourceChunk == Batch.SourceChunk; }))
+        return false;
+
+    for (const FFeatureBlockWrite& Write : Batch.Writes)
+    {
+        FFeatureWriter::ApplyBlock(ChunkInfo.Blocks, Write.LocalPos, Write.BlockType);
+    }
+
+    ChunkInfo.IncomingFeatureWrites.Add(Batch);
+    return true;
+}
+
+void ARandomMapGenerator::RouteFeatureWrites(const FChunkCoord& SourceChunk, TMap<FIntPoint, TArray<FFeatureBlockWrite>>& OutgoingWrites)
+{
+    for (auto& TargetPair : OutgoingWrites)
+    {
+        const FChunkCoord TargetChunk(TargetPair.Key.X, TargetPair.Key.Y);
+
+        // Harita dışı (dağ kenarı) chunk'lar arazi üretmez - eskisi gibi kırpılır
+        if (!IsChunkInsideMap(TargetChunk))
+            continue;
+
+        FFeatureWriteBatch Batch;
+        Batch.SourceChunk = FIntPoint(SourceChunk.X, SourceChunk.Y);
+        Batch.Writes = MoveTemp(TargetPair.Value);
+
+        FChunkInfo* TargetInfo = ChunksInfo.Find(TargetChunk);
+        if (TargetInfo && TargetInfo->bIsGenerated)
+        {
+            if (MergeFeatureWrites(*TargetInfo, Batch))
+            {
+                RebuildSurfaceHeights(*TargetInfo);
+                TargetInfo->ContentHash = ComputeChunkContentHash(TargetInfo->Blocks);
+                MarkChunkHashDirty(TargetChunk);
+
+                if (!bDeferBlockInstances)
+                {
+                    RequestChunkBuild(TargetChunk);
+                }
+            }
+        }
+        else
+        {
+            TArray<FFeatureWriteBatch>& Pending = PendingFeatureWrites.FindOrAdd(TargetChunk);
+            if (!Pending.ContainsByPredicate([&Batch](const FFeatureWriteBatch& Queued) { return Queued.SourceChunk == Batch.SourceChunk; }))
+            {
+                Pending.Add(MoveTemp(Batch));
+            }
+        }
+    }
+
+    OutgoingWrites.Empty();
+}
+
+// *** NEW: WORLD STREAMING ***
+// bStreamWorld: sadece pawn'ların ve base core'un yakınındaki chunk'lar üretilir/gösterilir, uzaklaşınca bırakılır.
+
+void ARandomMapGenerator::BuildChunkGenerationOrder()
+{
+    ChunkGenerationOrder.Reset();
+
+    if (!bStreamWorld)
+    {
+        // Chunk sırası blocking sürümle aynı (X dış, Y iç döngü)
+        for (int32 X = 0; X < WorldSizeInChunks; X++)
+        {
+            for (int32 Y = 0; Y < WorldSizeInChunks; Y++)
+            {
+                ChunkGenerationOrder.Add(FChunkCoord(X, Y));
+            }
+        }
+        return;
+    }
+
+    // Başlangıç seti: yükleme yarıçapındaki chunk'lar, yakından uzağa
+    TArray<FVector2D> Anchors;
+    GatherStreamingAnchors(Anchors);
+    RefreshStreamingQueue(Anchors);
+
+    while (StreamingQueue.Num() > 0)
+    {
+        FChunkStreamRequest Request;
+        StreamingQueue.HeapPop(Request, false);
+        ChunkGenerationOrder.Add(FChunkCoord(Request.ChunkCoord.X, Request.ChunkCoord.Y));
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("World streaming: %d of %d chunks in initial load radius"),
+        ChunkGenerationOrder.Num(), WorldSizeInChunks * WorldSizeInChunks);
+}
+
+bool ARandomMapGenerator::IsChunkInsideMap(const FChunkCoord& ChunkCoord) const
+{
+    return ChunkCoord.X >= 0 && ChunkCoord.Y >= 0 && ChunkCoord.X < WorldSizeInChunks && ChunkCoord.Y < WorldSizeInChunks;
+}
+
+void ARandomMapGenerator::GatherStreamingAnchors(TArray<FVector2D>& OutAnchors) const
+{
+    OutAnchors.Reset();
+
+    // Chunk biriminde konumlar
+    const float ChunkWorldSize = FMath::Max((BlockSize + BlockSpacing) * ChunkSize, 1.0f);
+
+    // Oyuncular ve AI (server'da düşmanların yürüdüğü zemin de yüklü kalmalı)
+    if (UWorld* World = GetWorld())
+    {
+        for (TActorIterator<APawn> It(World); It; ++It)
+        {
+            const FVector Location = It->GetActorLocation();
+            OutAnchors.Add(FVector2D(Location.X / ChunkWorldSize, Location.Y / ChunkWorldSize));
+        }
+    }
+
+    // Base core (henüz yoksa harita merkezi - base orada kurulur)
+    if (SpawnedBaseCore)
+    {
+        const FVector Location = SpawnedBaseCore->GetActorLocation();
+        OutAnchors.Add(FVector2D(Location.X / ChunkWorldSize, Location.Y / ChunkWorldSize));
+    }
+    else
+    {
+        OutAnchors.Add(FVector2D(WorldSizeInChunks * 0.5f, WorldSizeInChunks * 0.5f));
+    }
+}
+
+static float GetMinAnchorDistanceSquared(const TArray<FVector2D>& Anchors, const FIntPoint& ChunkCoord)
+{
+    const FVector2D ChunkCenter(ChunkCoord.X + 0.5f, ChunkCoord.Y + 0.5f);
+
+    float MinDistanceSq = MAX_FLT;
+    for (const FVector2D& Anchor : Anchors)
+    {
+        MinDistanceSq = FMath::Min(MinDistanceSq, static_cast<float>(FVector2D::DistSquared(Anchor, ChunkCenter)));
+    }
+    return MinDistanceSq;
+}
+
+void ARandomMapGenerator::UpdateWorldStreaming(float DeltaTime)
+{
+    StreamUpdateTimer -= DeltaTime;
+    if (StreamUpdateTimer <= 0.0f)
+    {
+        StreamUpdateTimer = StreamUpdateInterval;
+
+        TArray<FVector2D> Anchors;
+        GatherStreamingAnchors(Anchors);
+
+        // Dağ kenarı + mağaralar, kenara ilk yaklaşılınca (kenarlar birbirinden bağımsız, sıra sonucu değiştirmez)
+        if (bCreateMountainBorders && GeneratedEdgeFeatures != 0xF)
+        {
+            for (const FVector2D& Anchor : Anchors)
+            {
+                const bool bNearEdge[4] = {
+                    Anchor.Y < StreamLoadRadius,
+                    Anchor.Y > WorldSizeInChunks - StreamLoadRadius,
+                    Anchor.X < StreamLoadRadius,
+                    Anchor.X > WorldSizeInChunks - StreamLoadRadius };
+
+                for (int32 EdgeIndex = 0; EdgeIndex < 4; EdgeIndex++)
+                {
+                    if (bNearEdge[EdgeIndex] && !(GeneratedEdgeFeatures & (1 << EdgeIndex)))
+                    {
+                        GenerateEdgeFeatures(EdgeIndex);
+                    }
+                }
+            }
+        }
+
+        RefreshStreamingQueue(Anchors);
+        UnloadDistantChunks(Anchors);
+    }
+
+    ProcessStreamingQueue();
+}
+
+void ARandomMapGenerator::RefreshStreamingQueue(const TArray<FVector2D>& Anchors)
+{
+    StreamingQueue.Reset();
+
+    const float LoadRadiusSq = FMath::Square(StreamLoadRadius);
+    TSet<FIntPoint> Queued;
+
+    for (const FVector2D& Anchor : Anchors)
+    {
+        const int32 MinX = FMath::Max(0, FMath::FloorToInt(Anchor.X - StreamLoadRadius));
+        const int32 MaxX = FMath::Min(WorldSizeInChunks - 1, FMath::FloorToInt(Anchor.X + StreamLoadRadius));
+        const int32 MinY = FMath::Max(0, FMath::FloorToInt(Anchor.Y - StreamLoadRadius));
+        const int32 MaxY = FMath::Min(WorldSizeInChunks - 1, FMath::FloorToInt(Anchor.Y + StreamLoadRadius));
+
+        for (int32 X = MinX; X <= MaxX; X++)
+        {
+            for (int32 Y = MinY; Y <= MaxY; Y++)
+            {
+                const FIntPoint ChunkCoord(X, Y);
+                const FChunkInfo* ChunkInfo = ChunksInfo.Find(FChunkCoord(X, Y));
+                if ((ChunkInfo && ChunkInfo->bIsGenerated) || Queued.Contains(ChunkCoord))
+                    continue;
+
+                // Öncelik: en yakın anchor'a uzaklık
+                const float DistanceSq = GetMinAnchorDistanceSquared(Anchors, ChunkCoord);
+                if (DistanceSq > LoadRadiusSq)
+                    continue;
+
+                Queued.Add(ChunkCoord);
+                StreamingQueue.HeapPush(FChunkStreamRequest{ ChunkCoord, DistanceSq });
+            }
+        }
+    }
+}
+
+void ARandomMapGenerator::ProcessStreamingQueue()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = GenerationBudgetMs > 0.0f ? GenerationBudgetMs / 1000.0 : DBL_MAX;
+    const int32 BatchSize = bParallelChunkFill ? (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) * 2 : 1;
+
+    while (StreamingQueue.Num() > 0 && FPlatformTime::Seconds() - StartTime < BudgetSeconds)
+    {
+        // En yakın chunk'lar önce
+        TArray<FChunkCoord> BatchCoords;
+        while (StreamingQueue.Num() > 0 && BatchCoords.Num() < BatchSize)
+        {
+            FChunkStreamRequest Request;
+            StreamingQueue.HeapPop(Request, false);
+
+            const FChunkCoord ChunkCoord(Request.ChunkCoord.X, Request.ChunkCoord.Y);
+            const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+            if (!ChunkInfo || !ChunkInfo->bIsGenerated)
+            {
+                BatchCoords.Add(ChunkCoord);
+            }
+        }
+
+        if (BatchCoords.Num() == 0)
+            break;
+
+        GenerateChunksParallel(BatchCoords);
+
+        for (const FChunkCoord& ChunkCoord : BatchCoords)
+        {
+            RequestChunkBuild(ChunkCoord);
+            // Komşuların sınır yüzeyleri artık gizli olabilir
+            RequestNeighbourChunkBuilds(ChunkCoord);
+        }
+    }
+}
+
+void ARandomMapGenerator::UnloadDistantChunks(const TArray<FVector2D>& Anchors)
+{
+    // Yükleme yarıçapından büyük bir bırakma yarıçapı - sınırda gidip gelen pawn chunk'ları sürekli yeniden üretmez
+    const float UnloadRadiusSq = FMath::Square(FMath::Max(StreamUnloadRadius, StreamLoadRadius));
+
+    TArray<FChunkCoord> ChunksToUnload;
+    for (const auto& ChunkPair : ChunksInfo)
+    {
+        const FChunkInfo& ChunkInfo = ChunkPair.Value;
+        if (!ChunkInfo.bIsGenerated || ChunkInfo.bPinned || !IsChunkInsideMap(ChunkPair.Key))
+            continue;
+
+        if (GetMinAnchorDistanceSquared(Anchors, FIntPoint(ChunkPair.Key.X, ChunkPair.Key.Y)) > UnloadRadiusSq)
+        {
+            ChunksToUnload.Add(ChunkPair.Key);
+        }
+    }
+
+    for (const FChunkCoord& ChunkCoord : ChunksToUnload)
+    {
+        UnloadChunk(ChunkCoord);
+    }
+
+    if (ChunksToUnload.Num() > 0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("World streaming: unloaded %d chunks, %d loaded"), ChunksToUnload.Num(), ChunksInfo.Num());
+    }
+}
+
+void ARandomMapGenerator::UnloadChunk(const FChunkCoord& ChunkCoord)
+{
+    const FIntPoint ChunkKey(ChunkCoord.X, ChunkCoord.Y);
+
+    if (FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord))
+    {
+        if (ChunkInfo->BuildCancelToken.IsValid())
+        {
+            *ChunkInfo->BuildCancelToken = true;
+        }
+    }
+    PendingChunkBuilds.Remove(ChunkKey);
+
+    if (FChunkISMData* ChunkData = ChunkISMSystem.Find(ChunkCoord))
+    {
+        ReleaseChunkISMs(ChunkCoord, *ChunkData);
+        ChunkISMSystem.Remove(ChunkCoord);
+    }
+
+    if (FChunk* MeshChunk = Chunks.Find(ChunkKey))
+    {
+        if (MeshChunk->Mesh)
+        {
+            MeshChunk->Mesh->DestroyComponent();
+        }
+        Chunks.Remove(ChunkKey);
+    }
+
+    // Yüklü komşuların bu chunk'a taşan blokları tekrar gönderilmez - yeniden üretilince birleştirilmek üzere sakla
+    if (FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord))
+    {
+        if (ChunkInfo->IncomingFeatureWrites.Num() > 0)
+        {
+            PendingFeatureWrites.FindOrAdd(ChunkCoord).Append(MoveTemp(ChunkInfo->IncomingFeatureWrites));
+        }
+    }
+
+    ChunksInfo.Remove(ChunkCoord);
+
+    // Komşuların bu chunk'a bakan yüzleri tekrar görünür
+    RequestNeighbourChunkBuilds(ChunkCoord);
+}
+
+void ARandomMapGenerator::EnsureChunkGenerated(const FChunkCoord& ChunkCoord)
+{
+    if (!IsChunkInsideMap(ChunkCoord))
+        return;
+
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (ChunkInfo && ChunkInfo->bIsGenerated)
+        return;
+
+    GenerateChunk(ChunkCoord);
+
+    if (!bDeferBlockInstances)
+    {
+        RequestChunkBuild(ChunkCoord);
+        RequestNeighbourChunkBuilds(ChunkCoord);
+    }
+}
+
+void ARandomMapGenerator::RequestNeighbourChunkBuilds(const FChunkCoord& ChunkCoord)
+{
+    static const int32 Dirs[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+    for (const auto& Dir : Dirs)
+    {
+        const FChunkCoord NeighbourCoord(ChunkCoord.X + Dir[0], ChunkCoord.Y + Dir[1]);
+        if (ChunksInfo.Contains(NeighbourCoord))
+        {
+            RequestChunkBuild(NeighbourCoord);
+        }
+    }
+}
+
+void ARandomMapGenerator::GenerateEdgeFeatures(int32 EdgeIndex)
+{
+    UE_LOG(LogTemp, Warning, TEXT("World streaming: generating mountain edge %d and its caves"), EdgeIndex);
+
+    GeneratedEdgeFeatures |= (1 << EdgeIndex);
+
+    GenerateMountainRange(EdgeIndex);
+    GenerateEdgeCaves(EdgeIndex);
+
+    for (const auto& ChunkPair : ChunksInfo)
+    {
+        if (IsChunkOnEdge(ChunkPair.Key, EdgeIndex))
+        {
+            RequestChunkBuild(ChunkPair.Key);
+        }
+    }
+}
+
+bool ARandomMapGenerator::IsChunkOnEdge(const FChunkCoord& ChunkCoord, int32 EdgeIndex) const
+{
+    // Kenarın dışındaki border chunk'ları ve harita kenarındaki chunk satırı
+    return (EdgeIndex == 0 && ChunkCoord.Y <= 0) ||
+        (EdgeIndex == 1 && ChunkCoord.Y >= WorldSizeInChunks - 1) ||
+        (EdgeIndex == 2 && ChunkCoord.X <= 0) ||
+        (EdgeIndex == 3 && ChunkCoord.X >= WorldSizeInChunks - 1);
+}
+
+void ARandomMapGenerator::EnsureEdgeFeaturesForChunk(const FChunkCoord& ChunkCoord)
+{
+    // Streaming dışında kenarlar dünya üretiminde oluşur
+    if (!bStreamWorld || !bCreateMountainBorders || GeneratedEdgeFeatures == 0xF)
+        return;
+
+    for (int32 EdgeIndex = 0; EdgeIndex < 4; EdgeIndex++)
+    {
+        if (!(GeneratedEdgeFeatures & (1 << EdgeIndex)) && IsChunkOnEdge(ChunkCoord, EdgeIndex))
+        {
+            GenerateEdgeFeatures(EdgeIndex);
+        }
+    }
+}
+
+// *** NEW: HEIGHTMAP CACHE ***
+// Chunk başına iki katman: üretimdeki zemin yüksekliği (sabit) ve şu anki en üst katı blok (edit'lerle güncellenir).
+
+int32 ARandomMapGenerator::GetChunkSeedModifier(const FChunkCoord& ChunkCoord) const
+{
+    return (ChunkCoord.X * 73 + ChunkCoord.Y * 31 + Seed) % 1000;
+}
+
+bool ARandomMapGenerator::IsSurfaceBlockType(EBlockType BlockType)
+{
+    // Görünmez duvarlar üzerinde durulacak zemin değil
+    return BlockType != EBlockType::Air && BlockType != EBlockType::InvisibleWall;
+}
+
+bool ARandomMapGenerator::GetColumnChunk(int32 WorldX, int32 WorldY, FChunkCoord& OutChunkCoord, int32& OutColumn) const
+{
+    if (ChunkSize <= 0)
+        return false;
+
+    OutChunkCoord = FChunkCoord(FMath::FloorToInt(static_cast<float>(WorldX) / ChunkSize),
+        FMath::FloorToInt(static_cast<float>(WorldY) / ChunkSize));
+
+    int32 LocalX = WorldX % ChunkSize;
+    if (LocalX < 0) LocalX += ChunkSize;
+    int32 LocalY = WorldY % ChunkSize;
+    if (LocalY < 0) LocalY += ChunkSize;
+
+    OutColumn = LocalX * ChunkSize + LocalY;
+    return true;
+}
+
+int32 ARandomMapGenerator::GetCachedTerrainHeight(int32 WorldX, int32 WorldY) const
+{
+    FChunkCoord ChunkCoord;
+    int32 Column = 0;
+    if (!GetColumnChunk(WorldX, WorldY, ChunkCoord, Column))
+        return 0;
+
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (ChunkInfo && ChunkInfo->TerrainHeights.IsValidIndex(Column))
+    {
+        return ChunkInfo->TerrainHeights[Column];
+    }
+
+    // Üretilmemiş chunk: chunk'ın kendi modifier'ı ile noise'dan (üretilse çıkacak değerle aynı)
+    return GetTerrainHeight(WorldX, WorldY, GetChunkSeedModifier(ChunkCoord));
+}
+
+int32 ARandomMapGenerator::GetSurfaceHeight(int32 WorldX, int32 WorldY) const
+{
+    FChunkCoord ChunkCoord;
+    int32 Column = 0;
+    if (!GetColumnChunk(WorldX, WorldY, ChunkCoord, Column))
+        return 0;
+
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (ChunkInfo && ChunkInfo->SurfaceHeights.IsValidIndex(Column))
+    {
+        return ChunkInfo->SurfaceHeights[Column];
+    }
+
+    // Hiç bloğu olmayan chunk - üretilince çıkacak zemin
+    return GetCachedTerrainHeight(WorldX, WorldY);
+}
+
+void ARandomMapGenerator::RebuildSurfaceHeights(FChunkInfo& ChunkInfo) const
+{
+    const FChunkBlockStorage& ChunkBlocks = ChunkInfo.Blocks;
+    ChunkInfo.SurfaceHeights.SetNumZeroed(ChunkSize * ChunkSize);
+
+    for (int32 X = 0; X < ChunkSize; X++)
+    {
+        for (int32 Y = 0; Y < ChunkSize; Y++)
+        {
+            int32 Z = ChunkHeight - 1;
+            while (Z >= 0 && !IsSurfaceBlockType(ChunkBlocks.GetBlock(X, Y, Z)))
+            {
+                Z--;
+            }
+            ChunkInfo.SurfaceHeights[X * ChunkSize + Y] = static_cast<uint16>(Z + 1);
+        }
+    }
+}
+
+void ARandomMapGenerator::UpdateSurfaceHeight(FChunkInfo& ChunkInfo, const FBlockPosition& BlockPos, EBlockType NewBlockType) const
+{
+    const int32 Column = BlockPos.X * ChunkSize + BlockPos.Y;
+    if (!ChunkInfo.SurfaceHeights.IsValidIndex(Column))
+        return;
+
+    uint16& SurfaceHeight = ChunkInfo.SurfaceHeights[Column];
+    if (IsSurfaceBlockType(NewBlockType))
+    {
+        // Yüzeyin üstüne blok kondu
+        SurfaceHeight = FMath::Max<uint16>(SurfaceHeight, static_cast<uint16>(BlockPos.Z + 1));
+    }
+    else if (BlockPos.Z + 1 == SurfaceHeight)
+    {
+        // En üst blok kırıldı - altındaki ilk katı bloğu bul
+        int32 Z = BlockPos.Z - 1;
+        while (Z >= 0 && !IsSurfaceBlockType(ChunkInfo.Blocks.GetBlock(BlockPos.X, BlockPos.Y, Z)))
+        {
+            Z--;
+        }
+        SurfaceHeight = static_cast<uint16>(Z + 1);
+    }
+}
+
+int32 ARandomMapGenerator::ComposeTerrainHeight(int32 WorldX, int32 WorldY, int32 ChunkSeedModifier, float Noise, float SecondaryNoise) const
+{
+    // Haritanın merkezini hesapla
+    int32 CenterWorldX = (WorldSizeInChunks * ChunkSize) / 2;
+    int32 CenterWorldY = (WorldSizeInChunks * ChunkSize) / 2;
+
+    // Merkeze olan mesafeyi hesapla
+    int32 DistanceX = abs(WorldX - CenterWorldX);
+    int32 DistanceY = abs(WorldY - CenterWorldY);
+    float Distance = FMath::Sqrt(static_cast<float>(DistanceX * DistanceX + DistanceY * DistanceY));
+
+    // Base Core merkez bölgesi için düz alan yarat
+    float FlatnessFactor = 1.0f;
+
+    // Merkeze yakınsa düzleştir
+    if (Distance < BaseCoreCenter * ChunkSize)
+    {
+        // Merkezde tamamen düz, kenarlara doğru kademeli geçiş
+        FlatnessFactor = FMath::Clamp(Distance / (BaseCoreCenter * ChunkSize), 0.1f, 1.0f);
+    }
+
+    // Chunk spesifik seed modifierini bir miktar ekleyelim
+    float ChunkModifier = static_cast<float>(ChunkSeedModifier) / 2000.0f; // ±0.5 arasında
+
+    // Map noise (-1 to 1) to height variation
+    float HeightOffset = Noise * HeightVariation;
+
+    // Merkeze yakınsa düzleştir (FlatnessFactor ile çarp)
+    HeightOffset *= FlatnessFactor;
+
+    // Chunk bazlı ek varyasyon
+    HeightOffset += ChunkModifier * HeightVariation * FlatnessFactor;
+
+    // İkincil gürültü (daha fazla detay için)
+    HeightOffset += SecondaryNoise * 2.0f * FlatnessFactor;
+
+    // Adjust height based on flatness
+    float MapFlatnessFactor = 1.0f - MapFlatness;
+    HeightOffset *= MapFlatnessFactor;
+
+    // Calculate final height with a seed-based modifier
+    float SeedHeightModifier = (Seed % 50) / 10.0f - 2.5f; // -2.5 ile +2.5 arası
+    int32 Height = BaseHeight + FMath::RoundToInt(HeightOffset) + FMath::RoundToInt(SeedHeightModifier * FlatnessFactor);
+
+    // Clamp height to valid range
+    return FMath::Clamp(Height, 1, ChunkHeight - 1);
+}
+
+float ARandomMapGenerator::GetPerlinNoise(float X, float Y) const
+{
+    // Daha belirgin farklılıklar oluşturmak için seed'e dayalı offset ekleyelim
+    float XOffset = (Seed % 10000) * 0.01f;
+    float YOffset = (Seed % 7919) * 0.01f; // Asal sayı kullanıyoruz daha iyi dağılım için
+    // Girdi koordinatlarını doğrudan seed'den etkilenen bir faktörle genişletelim
+    float SeedFactor = 1.0f + ((Seed % 1000) / 10000.0f);
+    // Scaled coordinates with offsets and seed factor
+    float ScaledX = (X * NoiseScale * SeedFactor) + XOffset;
+    float ScaledY = (Y * NoiseScale * SeedFactor) + YOffset;
+    // İlk Perlin gürültüsü
+    float Noise1 = FTerrainNoise::Perlin2D(ScaledX, ScaledY);
+    // Seed'den etkilenen farklı bir ölçekte ikinci bir Perlin gürültüsü ekleyelim
+    // Bu, farklı seed'ler için daha çeşitli haritalar oluşturacak
+    float ScaleModifier = 0.5f + (float)(Seed % 5000) / 10000.0f;
+    float Noise2 = FTerrainNoise::Perlin2D(ScaledX * 2.0f * ScaleModifier, ScaledY * 2.0f * ScaleModifier) * 0.5f;
+    // Seed'e dayalı üçüncü bir gürültü
+    float Noise3 = FTerrainNoise::Perlin2D(ScaledX * 4.0f * (1.0f - ScaleModifier), ScaledY * 4.0f * (1.0f - ScaleModifier)) * 0.25f;
+    return CombineNoiseOctaves(Noise1, Noise2, Noise3);
+}
+
+float ARandomMapGenerator::CombineNoiseOctaves(float Noise1, float Noise2, float Noise3)
+{
+    // Tüm gürültüleri birleştir
+    float FinalNoise = (Noise1 + Noise2 + Noise3) / 1.75f;
+    // Sınırlama [-1, 1]
+    return FMath::Clamp(FinalNoise, -1.0f, 1.0f);
+}
+
+void ARandomMapGenerator::BenchmarkTerrainNoise(int32 Iterations)
+{
+    Iterations = FMath::Max(1, Iterations);
+
+    // 1) Ham kernel: FMath::PerlinNoise2D vs FTerrainNoise scalar vs batch
+    const int32 NumSamples = 4096;
+    TArray<float> SampleX, SampleY, OutEngine, OutScalar, OutBatch;
+    SampleX.SetNumUninitialized(NumSamples);
+    SampleY.SetNumUninitialized(NumSamples);
+    OutEngine.SetNumUninitialized(NumSamples);
+    OutScalar.SetNumUninitialized(NumSamples);
+    OutBatch.SetNumUninitialized(NumSamples);
+
+    FRandomStream SampleStream(Seed);
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        SampleX[i] = SampleStream.FRandRange(-512.0f, 512.0f);
+        SampleY[i] = SampleStream.FRandRange(-512.0f, 512.0f);
+    }
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        for (int32 i = 0; i < NumSamples; i++)
+        {
+            OutEngine[i] = FMath::PerlinNoise2D(FVector2D(SampleX[i], SampleY[i]));
+        }
+    }
+    const double EngineMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        for (int32 i = 0; i < NumSamples; i++)
+        {
+            OutScalar[i] = FTerrainNoise::Perlin2D(SampleX[i], SampleY[i]);
+        }
+    }
+    const double ScalarMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        FTerrainNoise::Perlin2DBatch(SampleX.GetData(), SampleY.GetData(), OutBatch.GetData(), NumSamples);
+    }
+    const double BatchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    float MaxEngineError = 0.0f;
+    int32 BatchMismatches = 0;
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        MaxEngineError = FMath::Max(MaxEngineError, FMath::Abs(OutEngine[i] - OutScalar[i]));
+        BatchMismatches += (OutBatch[i] != OutScalar[i]) ? 1 : 0;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("TerrainNoise kernel (%d samples x %d): FMath %.3f ms, scalar %.3f ms, batch %.3f ms (x%.2f) | max |FMath - scalar| = %g, batch != scalar: %d"),
+        NumSamples, Iterations, EngineMs, ScalarMs, BatchMs, BatchMs > 0.0 ? EngineMs / BatchMs : 0.0,
+        MaxEngineError, BatchMismatches);
+
+    // 2) Chunk yükseklikleri: kolon başına GetTerrainHeight vs GetChunkTerrainHeights
+    const int32 NumChunks = FMath::Max(1, WorldSizeInChunks * WorldSizeInChunks);
+    TArray<int32> ScalarHeights, BatchHeights;
+    ScalarHeights.SetNumUninitialized(ChunkSize * ChunkSize);
+    int32 HeightMismatches = 0;
+
+    double ColumnMs = 0.0;
+    double ChunkMs = 0.0;
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+    {
+        const FChunkCoord ChunkCoord(ChunkIndex / FMath::Max(1, WorldSizeInChunks), ChunkIndex % FMath::Max(1, WorldSizeInChunks));
+        const int32 ChunkSpecificSeedModifier = GetChunkSeedModifier(ChunkCoord);
+
+        StartTime = FPlatformTime::Seconds();
+        for (int32 X = 0; X < ChunkSize; X++)
+        {
+            for (int32 Y = 0; Y < ChunkSize; Y++)
+            {
+                ScalarHeights[X * ChunkSize + Y] = GetTerrainHeight(ChunkCoord.X * ChunkSize + X, ChunkCoord.Y * ChunkSize + Y, ChunkSpecificSeedModifier);
+            }
+        }
+        ColumnMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        StartTime = FPlatformTime::Seconds();
+        GetChunkTerrainHeights(ChunkCoord, ChunkSpecificSeedModifier, BatchHeights);
+        ChunkMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        for (int32 Column = 0; Column < ScalarHeights.Num(); Column++)
+        {
+            HeightMismatches += (ScalarHeights[Column] != BatchHeights[Column]) ? 1 : 0;
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("TerrainNoise heights (%d chunks): per column %.3f ms, per chunk batch %.3f ms | mismatching columns: %d"),
+        NumChunks, ColumnMs, ChunkMs, HeightMismatches);
+}
+
+void ARandomMapGenerator::SetBlockTypeAtPosition(const FVector& WorldLocation, EBlockType BlockType)
+{
+    // Only server can modify blocks
+    if (!HasAuthority())
+        return;
+    // Convert world position to chunk and block coordinates
+    FChunkCoord ChunkCoord = WorldToChunkCoord(WorldLocation);
+    FBlockPosition BlockPos = WorldToBlockPosition(WorldLocation);
+    // Ensure block position is valid
+    if (BlockPos.X < 0 || BlockPos.X >= ChunkSize ||
+        BlockPos.Y < 0 || BlockPos.Y >= ChunkSize ||
+        BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
+    {
+        return;
+    }
+    // Streaming: yüklenmemiş chunk'ın arazisi edit'ten önce üretilir (yoksa boş chunk pinlenir)
+    if (bStreamWorld)
+    {
+        EnsureChunkGenerated(ChunkCoord);
+    }
+    // Kenar sonradan üretilirse bu edit'i ezer
+    EnsureEdgeFeaturesForChunk(ChunkCoord);
+    // Make sure chunk is tracked - harita dışı border chunk'ları storage ile oluşur ama hiç üretilmez
+    FChunkInfo& ChunkInfo = FindOrAddChunkInfo(ChunkCoord);
+    if (!IsChunkInsideMap(ChunkCoord))
+    {
+        ChunkInfo.bIsGenerated = true;
+    }
+    // Get old block type
+    EBlockType OldBlockType = GetBlockInternal(ChunkCoord, BlockPos);
+    // If the block type hasn't changed, do nothing
+    if (OldBlockType == BlockType)
+        return;
+    // Log ekleme
+    UE_LOG(LogTemp, Display, TEXT("SetBlockTypeAtPosition: %s pozisyonundaki %d blok tipi %d olarak değiştiriliyor"),
+        *WorldLocation.ToString(), static_cast<int32>(OldBlockType), static_cast<int32>(BlockType));
+    // Update block data on server
+    SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
+    // Clear damage data if block is removed or changed
+    FWorldBlockKey Key(ChunkCoord, BlockPos);
+    if (BlockType == EBlockType::Air || OldBlockType != BlockType)
+    {
+        BlockDamageData.Remove(Key);
+        // Also clear from DestroyedBlocksProcessed map
+        DestroyedBlocksProcessed.Remove(Key);
+        // Temizle from ProcessedDestroyedBlocks
+        FString BlockKey = FString::Printf(TEXT("%d_%d_%d_%d_%d"),
+            ChunkCoord.X, ChunkCoord.Y,
+            BlockPos.X, BlockPos.Y, BlockPos.Z);
+        ProcessedDestroyedBlocks.Remove(BlockKey);
+    }
+    // Eski instance'ı kaldır, yeni bloğu ve açığa çıkan/örtülen komşuları güncelle
+    RefreshBlockInstancesAround(ChunkCoord, BlockPos, OldBlockType);
+    // Replicate to clients (tick sonunda chunk delta'sı olarak)
+    QueueBlockDelta(ChunkCoord, BlockPos, BlockType);
+}
+
+EBlockType ARandomMapGenerator::GetBlockTypeAtPosition(const FVector& WorldLocation) const
+{
+    // Convert world position to chunk and block coordinates
+    FChunkCoord ChunkCoord = WorldToChunkCoord(WorldLocation);
+    FBlockPosition BlockPos = WorldToBlockPosition(WorldLocation);
+    // Ensure block position is valid
+    if (BlockPos.X < 0 || BlockPos.X >= ChunkSize ||
+        BlockPos.Y < 0 || BlockPos.Y >= ChunkSize ||
+        BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
+    {
+        return EBlockType::Air;
+    }
+    return GetBlockInternal(ChunkCoord, BlockPos);
+}
+
+// *** UPDATED: CHUNK-BASED INSTANCE MANAGEMENT ***
+void ARandomMapGenerator::UpdateBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+{
+    if (BlockType == EBlockType::Air) return;
+
+    // Bu tipin chunk'taki ilk instance'ıysa component burada oluşur
+    UInstancedStaticMeshComponent* ChunkISM = GetOrCreateChunkISM(ChunkCoord, BlockType);
+
+    if (!ChunkISM)
+    {
+        UE_LOG(LogTemp, Error, TEXT("No chunk ISM found for block type %d in chunk (%d,%d)"),
+            (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
+        return;
+    }
+
+    // World position hesapla
+    FVector WorldPosition = BlockToWorldPosition(ChunkCoord, BlockPos);
+    FTransform InstanceTransform = FTransform(FRotator::ZeroRotator, WorldPosition);
+
+    // Instance'ı ekle
+    int32 InstanceIndex = ChunkISM->AddInstance(InstanceTransform);
+
+    // Instance mapping'e ekle - FIXED: Combined key approach
+    FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
+    const EBlockType Slot = GetChunkISMSlot(BlockType);
+    FBlockTypePositionKey MappingKey(BlockType, BlockPos);
+    ChunkData.InstanceIndexMapping.Add(MappingKey, InstanceIndex);
+    ChunkData.InstanceCounts[Slot]++;
+
+    // Ters index: yeni instance her zaman dizinin sonuna eklenir
+    TArray<FBlockTypePositionKey>& InstanceKeys = ChunkData.InstanceKeys.FindOrAdd(Slot);
+    if (InstanceKeys.Num() <= InstanceIndex)
+    {
+        InstanceKeys.SetNum(InstanceIndex + 1);
+    }
+    InstanceKeys[InstanceIndex] = MappingKey;
+
+    if (Slot == EBlockType::Air)
+    {
+        TArray<float> CustomData;
+        FillSharedInstanceCustomData(ChunkCoord, BlockPos, BlockType, CustomData);
+        ChunkISM->SetCustomData(InstanceIndex, CustomData, true);
+    }
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Added instance %d for block type %d at chunk (%d,%d) local pos (%d,%d,%d) world pos %s"),
+        InstanceIndex, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y,
+        BlockPos.X, BlockPos.Y, BlockPos.Z, *WorldPosition.ToString());
+}
+
+void ARandomMapGenerator::RemoveBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+{
+    if (BlockType == EBlockType::Air) return;
+
+    if (!ChunkISMSystem.Contains(ChunkCoord))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No chunk ISM data for chunk (%d,%d) when trying to remove block"),
+            ChunkCoord.X, ChunkCoord.Y);
+        return;
+    }
 
-    // Base Core merkez bölgesi için düz alan yarat
-    float FlatnessFactor = 1.0f;
+    FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
+    const EBlockType Slot = GetChunkISMSlot(BlockType);
+    UInstancedStaticMeshComponent* ChunkISM = ChunkData.ChunkISMs.FindRef(Slot);
 
-    // Merkeze yakınsa düzleştir
-    if (Distance < BaseCoreCenter * ChunkSize)
+    if (!ChunkISM)
     {
-        // Merkezde tamamen düz, kenarlara doğru kademeli geçiş
-        FlatnessFactor = FMath::Clamp(Distance / (BaseCoreCenter * ChunkSize), 0.1f, 1.0f);
+        UE_LOG(LogTemp, Warning, TEXT("No chunk ISM for block type %d in chunk (%d,%d)"),
+            (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
+        return;
     }
 
-    // Apply Perlin noise to base height
-    float Noise = GetPerlinNoise(WorldX, WorldY);
+    // Instance mapping'den instance index'i bul - FIXED: Combined key approach
+    FBlockTypePositionKey MappingKey(BlockType, BlockPos);
+    int32* FoundInstanceIndex = ChunkData.InstanceIndexMapping.Find(MappingKey);
 
-    // Chunk spesifik seed modifierini bir miktar ekleyelim
-    float ChunkModifier = static_cast<float>(ChunkSeedModifier) / 2000.0f; // ±0.5 arasında
+    if (!FoundInstanceIndex)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Instance not found for block pos (%d,%d,%d) type %d in chunk (%d,%d)"),
+            BlockPos.X, BlockPos.Y, BlockPos.Z, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
 
-    // Map noise (-1 to 1) to height variation
-    float HeightOffset = Noise * HeightVariation;
+        // Debug: Mapping'deki tüm instance'ları listele
+        UE_LOG(LogTemp, Warning, TEXT("Available instances in chunk (%d,%d):"),
+            ChunkCoord.X, ChunkCoord.Y);
+        for (const auto& Pair : ChunkData.InstanceIndexMapping)
+        {
+            if (Pair.Key.BlockType == BlockType)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("  Type %d Pos(%d,%d,%d) -> Instance %d"),
+                    (int32)Pair.Key.BlockType, Pair.Key.BlockPos.X, Pair.Key.BlockPos.Y, Pair.Key.BlockPos.Z, Pair.Value);
+            }
+        }
+        return;
+    }
 
-    // Merkeze yakınsa düzleştir (FlatnessFactor ile çarp)
-    HeightOffset *= FlatnessFactor;
+    int32 InstanceIndexToRemove = *FoundInstanceIndex;
 
-    // Chunk bazlı ek varyasyon
-    HeightOffset += ChunkModifier * HeightVariation * FlatnessFactor;
+    // Double-check: Instance'ın pozisyonu doğru mu?
+    FTransform InstanceTransform;
+    if (ChunkISM->GetInstanceTransform(InstanceIndexToRemove, InstanceTransform))
+    {
+        FVector ExpectedWorldPos = BlockToWorldPosition(ChunkCoord, BlockPos);
+        float DistanceSq = FVector::DistSquared(InstanceTransform.GetLocation(), ExpectedWorldPos);
 
-    // Küçük bir ikincil gürültü ekleyelim (daha fazla detay için)
-    float SecondaryNoise = FMath::PerlinNoise2D(FVector2D(WorldX * 0.1f + Seed * 0.01f, WorldY * 0.1f)) * 2.0f;
-    HeightOffset += SecondaryNoise * FlatnessFactor;
+        if (DistanceSq > 1.0f) // 1 unit tolerance
+        {
+            UE_LOG(LogTemp, Error, TEXT("Instance position mismatch! Expected: %s, Found: %s, Distance: %f"),
+                *ExpectedWorldPos.ToString(), *InstanceTransform.GetLocation().ToString(), FMath::Sqrt(DistanceSq));
+        }
+    }
 
-    // Adjust height based on flatness
-    float MapFlatnessFactor = 1.0f - MapFlatness;
-    HeightOffset *= MapFlatnessFactor;
+    // Yeni:
+    if (SwapRemoveInstance(ChunkISM, ChunkData, MappingKey))
+    {
+        ChunkData.InstanceCounts[Slot]--;
 
-    // Calculate final height with a seed-based modifier
-    float SeedHeightModifier = (Seed % 50) / 10.0f - 2.5f; // -2.5 ile +2.5 arası
-    int32 Height = BaseHeight + FMath::RoundToInt(HeightOffset) + FMath::RoundToInt(SeedHeightModifier * FlatnessFactor);
+        // Tipin son instance'ı gittiyse component'i serbest bırak
+        ReleaseChunkISMIfEmpty(ChunkCoord, ChunkData, Slot);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Successfully removed instance %d for block type %d at chunk (%d,%d) pos (%d,%d,%d)"),
+        InstanceIndexToRemove, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y, BlockPos.X, BlockPos.Y, BlockPos.Z);
+}
+
+// *** NEW: HIDDEN-FACE CULLING ***
+// Sadece en az bir yüzü görünür (komşusu opak olmayan) bloklar ISM instance alır.
+// Tamamen gömülü Stone/Dirt blokları hiç instance almaz, kazıldığında açığa çıkınca eklenir.
+
+bool ARandomMapGenerator::IsOpaqueBlockType(EBlockType BlockType)
+{
+    // Tam küp ve ışık geçirmeyen tipler komşularını örter.
+    // Leaves (masked), functional bloklar ve InvisibleWall örtmez.
+    switch (BlockType)
+    {
+    case EBlockType::Grass:
+    case EBlockType::Dirt:
+    case EBlockType::Stone:
+    case EBlockType::Wood:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ARandomMapGenerator::GetNeighbourBlockPosition(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos,
+    int32 OffsetX, int32 OffsetY, int32 OffsetZ, FChunkCoord& OutChunkCoord, FBlockPosition& OutBlockPos) const
+{
+    int32 NeighbourZ = BlockPos.Z + OffsetZ;
+    if (NeighbourZ < 0 || NeighbourZ >= ChunkHeight)
+    {
+        return false;
+    }
+
+    int32 WorldX = ChunkCoord.X * ChunkSize + BlockPos.X + OffsetX;
+    int32 WorldY = ChunkCoord.Y * ChunkSize + BlockPos.Y + OffsetY;
+
+    OutChunkCoord = FChunkCoord(FMath::FloorToInt(static_cast<float>(WorldX) / ChunkSize),
+        FMath::FloorToInt(static_cast<float>(WorldY) / ChunkSize));
+    OutBlockPos = FBlockPosition(WorldX - OutChunkCoord.X * ChunkSize, WorldY - OutChunkCoord.Y * ChunkSize, NeighbourZ);
+    return true;
+}
+
+bool ARandomMapGenerator::IsBlockExposed(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos) const
+{
+    static const int32 NeighbourOffsets[6][3] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+
+    for (const int32* Offset : NeighbourOffsets)
+    {
+        int32 NX = BlockPos.X + Offset[0];
+        int32 NY = BlockPos.Y + Offset[1];
+        int32 NZ = BlockPos.Z + Offset[2];
+
+        // Dünyanın altı hiçbir zaman görünmez
+        if (NZ < 0)
+            continue;
+
+        // Dünyanın üstü her zaman açık hava
+        if (NZ >= ChunkHeight)
+            return true;
+
+        EBlockType NeighbourType;
+        if (ChunkInfo && ChunkInfo->Blocks.IsValidPosition(NX, NY, NZ))
+        {
+            // Hızlı yol: komşu aynı chunk'ta
+            NeighbourType = ChunkInfo->Blocks.GetBlock(NX, NY, NZ);
+        }
+        else
+        {
+            FChunkCoord NeighbourChunk;
+            FBlockPosition NeighbourPos;
+            GetNeighbourBlockPosition(ChunkCoord, BlockPos, Offset[0], Offset[1], Offset[2], NeighbourChunk, NeighbourPos);
+            NeighbourType = GetBlockInternal(NeighbourChunk, NeighbourPos);
+        }
+
+        if (!IsOpaqueBlockType(NeighbourType))
+            return true;
+    }
+
+    return false;
+}
+
+bool ARandomMapGenerator::NeedsBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType) const
+{
+    if (BlockType == EBlockType::Air)
+        return false;
+
+    // Merged mesh modunda atlas blokları chunk mesh'inde çizilir
+    if (IsMeshedBlockType(BlockType))
+        return false;
+
+    // Opak olmayan bloklar (InvisibleWall collision'ı dahil) her zaman instance ister
+    if (!IsOpaqueBlockType(BlockType))
+        return true;
+
+    return IsBlockExposed(ChunkCoord, BlockPos);
+}
+
+bool ARandomMapGenerator::HasBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType) const
+{
+    const FChunkISMData* ChunkData = ChunkISMSystem.Find(ChunkCoord);
+    return ChunkData && ChunkData->InstanceIndexMapping.Contains(FBlockTypePositionKey(BlockType, BlockPos));
+}
+
+void ARandomMapGenerator::RefreshBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos)
+{
+    // Chunk'ın bekleyen/çalışan bir build'i var: sonucu bu değişikliği görmeyebilir, build'i yeniden iste
+    if (IsChunkBuildPending(ChunkCoord))
+    {
+        RequestChunkBuild(ChunkCoord);
+        return;
+    }
+
+    EBlockType BlockType = GetBlockInternal(ChunkCoord, BlockPos);
+    if (BlockType == EBlockType::Air)
+        return;
+
+    bool bNeedsInstance = NeedsBlockInstance(ChunkCoord, BlockPos, BlockType);
+    bool bHasInstance = HasBlockInstance(ChunkCoord, BlockPos, BlockType);
+
+    if (bNeedsInstance && !bHasInstance)
+    {
+        UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
+    }
+    else if (!bNeedsInstance && bHasInstance)
+    {
+        RemoveBlockInstance(ChunkCoord, BlockPos, BlockType);
+    }
+}
+
+void ARandomMapGenerator::RefreshBlockInstancesAround(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType OldBlockType)
+{
+    if (bDeferBlockInstances)
+        return;
+
+    // Merged mesh modunda chunk mesh'i (ve sınırdaysa komşu chunk mesh'i) yeniden oluşturulacak
+    if (ChunkRenderMode == EChunkRenderMode::MergedMesh)
+    {
+        MarkChunkMeshDirty(ChunkCoord, BlockPos);
+    }
+
+    // Eski tipin instance'ı (varsa) kaldır - gömülü blokların instance'ı yoktur.
+    // Build bekleyen chunk'ta instance'lar zaten build sonucuyla değiştirilecek.
+    EBlockType NewBlockType = GetBlockInternal(ChunkCoord, BlockPos);
+    if (OldBlockType != EBlockType::Air && OldBlockType != NewBlockType &&
+        !IsChunkBuildPending(ChunkCoord) && HasBlockInstance(ChunkCoord, BlockPos, OldBlockType))
+    {
+        RemoveBlockInstance(ChunkCoord, BlockPos, OldBlockType);
+    }
+
+    // Bloğun kendisi
+    RefreshBlockInstance(ChunkCoord, BlockPos);
+
+    // 6 komşu: kazılan blok komşularını açığa çıkarır, konan blok onları örtebilir
+    static const int32 NeighbourOffsets[6][3] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    for (const int32* Offset : NeighbourOffsets)
+    {
+        FChunkCoord NeighbourChunk;
+        FBlockPosition NeighbourPos;
+        if (GetNeighbourBlockPosition(ChunkCoord, BlockPos, Offset[0], Offset[1], Offset[2], NeighbourChunk, NeighbourPos))
+        {
+            RefreshBlockInstance(NeighbourChunk, NeighbourPos);
+        }
+    }
+}
+
+void ARandomMapGenerator::BuildAllChunkInstances()
+{
+    // Border chunk'ları da dahil tüm chunk'lar
+    TArray<FChunkCoord> ChunkCoords;
+    ChunksInfo.GetKeys(ChunkCoords);
+
+    CacheBlockAtlasTiles();
+
+    for (const FChunkCoord& ChunkCoord : ChunkCoords)
+    {
+        RequestChunkBuild(ChunkCoord);
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("Hidden-face culling: %d chunk build queued (%s)"),
+        ChunkCoords.Num(), bAsyncChunkBuilds ? TEXT("async") : TEXT("game thread"));
+
+    FlushChunkBuildRequests();
+}
+
+// *** NEW: GREEDY-MESHED CHUNK RENDERER ***
+// Aynı düzlemdeki aynı tip yüzler tek bir quad'da birleştirilir; chunk başına tek mesh section.
+
+void ARandomMapGenerator::CacheBlockAtlasTiles()
+{
+    BlockAtlasTiles.Reset();
+    BlockAtlasTiles.SetNum(static_cast<int32>(EBlockType::MAX));
+
+    if (!BlockDataTable)
+        return;
+
+    for (int32 TypeIdx = 1; TypeIdx < static_cast<int32>(EBlockType::MAX); TypeIdx++)
+    {
+        EBlockType BlockType = static_cast<EBlockType>(TypeIdx);
+
+        // InvisibleWall görünmez, collision için HISM'de kalır
+        if (BlockType == EBlockType::InvisibleWall)
+            continue;
+
+        FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
+        FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
+        if (!BlockDataRow || BlockDataRow->bIsFunctionalBlock)
+            continue;
+
+        FBlockAtlasTiles& Tiles = BlockAtlasTiles[TypeIdx];
+        Tiles.bMeshed = true;
+        Tiles.TopTile = BlockDataRow->TopTile;
+        Tiles.SideTile = BlockDataRow->SideTile;
+        Tiles.BottomTile = BlockDataRow->BottomTile;
+    }
+
+    if (ChunkRenderMode == EChunkRenderMode::SharedInstancedMesh)
+    {
+        InitializeSharedCubeMaterial();
+    }
+}
+
+bool ARandomMapGenerator::IsMeshedBlockType(EBlockType BlockType) const
+{
+    if (ChunkRenderMode != EChunkRenderMode::MergedMesh)
+        return false;
+
+    const int32 TypeIdx = static_cast<int32>(BlockType);
+    return BlockAtlasTiles.IsValidIndex(TypeIdx) && BlockAtlasTiles[TypeIdx].bMeshed;
+}
+
+// *** NEW: SHARED CHUNK ISM (PER-INSTANCE CUSTOM DATA) ***
+// Tüm küp tipleri chunk başına tek HISM'i paylaşır; tip (ve hasar) PerInstanceCustomData'da taşınır,
+// BlockDataTable'daki tip başına görünüm ayarları texture array material'ine parametre olarak verilir.
+
+bool ARandomMapGenerator::IsSharedCubeBlockType(EBlockType BlockType) const
+{
+    if (ChunkRenderMode != EChunkRenderMode::SharedInstancedMesh)
+        return false;
+
+    const int32 TypeIdx = static_cast<int32>(BlockType);
+    return BlockAtlasTiles.IsValidIndex(TypeIdx) && BlockAtlasTiles[TypeIdx].bMeshed;
+}
+
+EBlockType ARandomMapGenerator::GetChunkISMSlot(EBlockType BlockType) const
+{
+    // Ortak component ChunkISMs'de Air anahtarıyla durur (Air'in kendi instance'ı olmaz)
+    return IsSharedCubeBlockType(BlockType) ? EBlockType::Air : BlockType;
+}
+
+int32 ARandomMapGenerator::GetSharedCustomDataFloats() const
+{
+    return bSharedMeshDamageCustomData ? 2 : 1;
+}
+
+void ARandomMapGenerator::InitializeSharedCubeMaterial()
+{
+    if (!SharedCubeMaterial)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SharedInstancedMesh mode without SharedCubeMaterial - shared chunk ISMs use the mesh's default material"));
+        return;
+    }
+
+    if (!SharedCubeMaterialInstance)
+    {
+        SharedCubeMaterialInstance = UMaterialInstanceDynamic::Create(SharedCubeMaterial, this);
+    }
+
+    // <Tip>_TopLayer / _SideLayer / _BottomLayer: atlas tile'ının texture array katmanı (satır sıralı)
+    const int32 Cols = FMath::Max(1, AtlasCols);
+    auto TileToLayer = [Cols](const FVector2D& Tile) -> float
+    {
+        return Tile.Y * Cols + Tile.X;
+    };
+
+    for (int32 TypeIdx = 1; TypeIdx < BlockAtlasTiles.Num(); TypeIdx++)
+    {
+        const FBlockAtlasTiles& Tiles = BlockAtlasTiles[TypeIdx];
+        if (!Tiles.bMeshed)
+            continue;
+
+        FString TypeName = UEnum::GetValueAsString(static_cast<EBlockType>(TypeIdx)).Replace(TEXT("EBlockType::"), TEXT(""));
+        SharedCubeMaterialInstance->SetScalarParameterValue(FName(*(TypeName + TEXT("_TopLayer"))), TileToLayer(Tiles.TopTile));
+        SharedCubeMaterialInstance->SetScalarParameterValue(FName(*(TypeName + TEXT("_SideLayer"))), TileToLayer(Tiles.SideTile));
+        SharedCubeMaterialInstance->SetScalarParameterValue(FName(*(TypeName + TEXT("_BottomLayer"))), TileToLayer(Tiles.BottomTile));
+    }
+}
+
+void ARandomMapGenerator::FillSharedInstanceCustomData(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType, TArray<float>& OutCustomData) const
+{
+    OutCustomData.Reset(2);
+
+    // 0: blok tipi - material tip parametreleri arasından seçer
+    OutCustomData.Add(static_cast<float>(BlockType));
+
+    // 1: hasar oranı (0 = sağlam, 1 = kırılmak üzere)
+    if (bSharedMeshDamageCustomData)
+    {
+        float DamageRatio = 0.0f;
+        if (const FBlockDamageData* DamageData = BlockDamageData.Find(FWorldBlockKey(ChunkCoord, BlockPos)))
+        {
+            DamageRatio = FMath::Clamp(1.0f - DamageData->CurrentHealth / FMath::Max(DamageData->MaxHealth, KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+        }
+        OutCustomData.Add(DamageRatio);
+    }
+}
+
+void ARandomMapGenerator::UpdateBlockDamageCustomData(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+{
+    if (!bSharedMeshDamageCustomData || !IsSharedCubeBlockType(BlockType))
+        return;
+
+    FChunkISMData* ChunkData = ChunkISMSystem.Find(ChunkCoord);
+    if (!ChunkData)
+        return;
+
+    // Gömülü (instance'ı olmayan) blok hasar alamaz ama yine de kontrol et
+    const int32* InstanceIndex = ChunkData->InstanceIndexMapping.Find(FBlockTypePositionKey(BlockType, BlockPos));
+    UHierarchicalInstancedStaticMeshComponent* SharedISM = ChunkData->ChunkISMs.FindRef(EBlockType::Air);
+    if (!InstanceIndex || !SharedISM)
+        return;
+
+    TArray<float> CustomData;
+    FillSharedInstanceCustomData(ChunkCoord, BlockPos, BlockType, CustomData);
+    SharedISM->SetCustomData(*InstanceIndex, CustomData, true);
+}
+
+FVector2D ARandomMapGenerator::GetTileUV(const FVector2D& Tile, int32 CornerIndex) const
+{
+    return FChunkMeshBuilder::GetTileUV(Tile, CornerIndex, AtlasCols, AtlasRows);
+}
+
+void ARandomMapGenerator::RebuildChunk(const FIntPoint& ChunkCoord)
+{
+    RequestChunkBuild(FChunkCoord(ChunkCoord.X, ChunkCoord.Y));
+}
+
+void ARandomMapGenerator::MarkChunkMeshDirty(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos)
+{
+    RequestChunkBuild(ChunkCoord);
+
+    // Sınırdaki bloklar komşu chunk'ın yüzlerini de etkiler
+    if (BlockPos.X == 0) RequestChunkBuild(FChunkCoord(ChunkCoord.X - 1, ChunkCoord.Y));
+    if (BlockPos.X == ChunkSize - 1) RequestChunkBuild(FChunkCoord(ChunkCoord.X + 1, ChunkCoord.Y));
+    if (BlockPos.Y == 0) RequestChunkBuild(FChunkCoord(ChunkCoord.X, ChunkCoord.Y - 1));
+    if (BlockPos.Y == ChunkSize - 1) RequestChunkBuild(FChunkCoord(ChunkCoord.X, ChunkCoord.Y + 1));
+}
+
+// *** NEW: ASYNC CHUNK BUILDS ***
+// Chunk geometrisi (görünür instance'lar + merged mesh) worker thread'de bir snapshot'tan üretilir,
+// game thread sadece snapshot alır ve sonucu component'lere yazar.
+// Her istek chunk'a yeni bir versiyon verir; başka versiyonlu sonuçlar bayattır ve atılır.
+
+void ARandomMapGenerator::RequestChunkBuild(const FChunkCoord& ChunkCoord)
+{
+    FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (!ChunkInfo)
+        return;
 
-    // Clamp height to valid range
-    return FMath::Clamp(Height, 1, ChunkHeight - 1);
+    // Çalışan eski build artık boşa iş yapmasın
+    if (ChunkInfo->BuildCancelToken.IsValid())
+    {
+        *ChunkInfo->BuildCancelToken = true;
+        ChunkInfo->BuildCancelToken.Reset();
+    }
+
+    ChunkInfo->PendingBuildVersion = ++LastChunkBuildVersion;
+    PendingChunkBuilds.Add(FIntPoint(ChunkCoord.X, ChunkCoord.Y));
 }
 
-float ARandomMapGenerator::GetPerlinNoise(float X, float Y) const
+bool ARandomMapGenerator::IsChunkBuildPending(const FChunkCoord& ChunkCoord) const
 {
-    // Daha belirgin farklılıklar oluşturmak için seed'e dayalı offset ekleyelim
-    float XOffset = (Seed % 10000) * 0.01f;
-    float YOffset = (Seed % 7919) * 0.01f; // Asal sayı kullanıyoruz daha iyi dağılım için
-    // Girdi koordinatlarını doğrudan seed'den etkilenen bir faktörle genişletelim
-    float SeedFactor = 1.0f + ((Seed % 1000) / 10000.0f);
-    // Scaled coordinates with offsets and seed factor
-    float ScaledX = (X * NoiseScale * SeedFactor) + XOffset;
-    float ScaledY = (Y * NoiseScale * SeedFactor) + YOffset;
-    // İlk Perlin gürültüsü
-    float Noise1 = FMath::PerlinNoise2D(FVector2D(ScaledX, ScaledY));
-    // Seed'den etkilenen farklı bir ölçekte ikinci bir Perlin gürültüsü ekleyelim
-    // Bu, farklı seed'ler için daha çeşitli haritalar oluşturacak
-    float ScaleModifier = 0.5f + (float)(Seed % 5000) / 10000.0f;
-    float Noise2 = FMath::PerlinNoise2D(FVector2D(ScaledX * 2.0f * ScaleModifier, ScaledY * 2.0f * ScaleModifier)) * 0.5f;
-    // Seed'e dayalı üçüncü bir gürültü
-    float Noise3 = FMath::PerlinNoise2D(FVector2D(ScaledX * 4.0f * (1.0f - ScaleModifier), ScaledY * 4.0f * (1.0f - ScaleModifier))) * 0.25f;
-    // Tüm gürültüleri birleştir
-    float FinalNoise = (Noise1 + Noise2 + Noise3) / 1.75f;
-    // Sınırlama [-1, 1]
-    return FMath::Clamp(FinalNoise, -1.0f, 1.0f);
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    return ChunkInfo && ChunkInfo->PendingBuildVersion != 0;
 }
 
-void ARandomMapGenerator::SetBlockTypeAtPosition(const FVector& WorldLocation, EBlockType BlockType)
+void ARandomMapGenerator::FlushChunkBuildRequests()
 {
-    // Only server can modify blocks
-    if (!HasAuthority())
-        return;
-    // Convert world position to chunk and block coordinates
-    FChunkCoord ChunkCoord = WorldToChunkCoord(WorldLocation);
-    FBlockPosition BlockPos = WorldToBlockPosition(WorldLocation);
-    // Ensure block position is valid
-    if (BlockPos.X < 0 || BlockPos.X >= ChunkSize ||
-        BlockPos.Y < 0 || BlockPos.Y >= ChunkSize ||
-        BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
+    TSet<FIntPoint> ChunksToBuild = MoveTemp(PendingChunkBuilds);
+    PendingChunkBuilds.Reset();
+
+    for (const FIntPoint& Coord : ChunksToBuild)
     {
-        return;
+        const FChunkCoord ChunkCoord(Coord.X, Coord.Y);
+        FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+        if (!ChunkInfo || ChunkInfo->PendingBuildVersion == 0)
+            continue;
+
+        TSharedRef<FChunkBuildSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FChunkBuildSnapshot, ESPMode::ThreadSafe>();
+        CreateChunkBuildSnapshot(ChunkCoord, *ChunkInfo, *Snapshot);
+
+        if (!bAsyncChunkBuilds)
+        {
+            FChunkBuildResult Result;
+            FChunkMeshBuilder::Build(*Snapshot, Result);
+            CommitChunkBuild(Result);
+            continue;
+        }
+
+        ChunkInfo->BuildCancelToken = MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(false);
+        Snapshot->CancelToken = ChunkInfo->BuildCancelToken;
+        NumChunkBuildsInFlight++;
+
+        TWeakObjectPtr<ARandomMapGenerator> WeakThis(this);
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Snapshot]()
+        {
+            TSharedRef<FChunkBuildResult, ESPMode::ThreadSafe> Result = MakeShared<FChunkBuildResult, ESPMode::ThreadSafe>();
+            const bool bCompleted = FChunkMeshBuilder::Build(*Snapshot, *Result);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Result, bCompleted]()
+            {
+                ARandomMapGenerator* Generator = WeakThis.Get();
+                if (!Generator)
+                    return;
+
+                Generator->NumChunkBuildsInFlight--;
+                if (bCompleted)
+                {
+                    Generator->CommitChunkBuild(*Result);
+                }
+            });
+        });
     }
-    // Make sure chunk is tracked
-    if (!ChunksInfo.Contains(ChunkCoord))
+}
+
+void ARandomMapGenerator::CreateChunkBuildSnapshot(const FChunkCoord& ChunkCoord, const FChunkInfo& ChunkInfo, FChunkBuildSnapshot& OutSnapshot) const
+{
+    OutSnapshot.ChunkCoord = FIntPoint(ChunkCoord.X, ChunkCoord.Y);
+    OutSnapshot.ChunkSize = ChunkSize;
+    OutSnapshot.ChunkHeight = ChunkHeight;
+    OutSnapshot.BlockSize = BlockSize;
+    OutSnapshot.BlockSpacing = BlockSpacing;
+    OutSnapshot.AtlasCols = AtlasCols;
+    OutSnapshot.AtlasRows = AtlasRows;
+    OutSnapshot.bBuildMergedMesh = (ChunkRenderMode == EChunkRenderMode::MergedMesh);
+    OutSnapshot.Version = ChunkInfo.PendingBuildVersion;
+
+    for (int32 TypeIdx = 0; TypeIdx < static_cast<int32>(EBlockType::MAX); TypeIdx++)
     {
-        // Create new chunk info if it doesn't exist
-        FChunkInfo ChunkInfo(ChunkCoord);
-        ChunkInfo.bIsGenerated = true;
-        ChunksInfo.Add(ChunkCoord, ChunkInfo);
+        EBlockType BlockType = static_cast<EBlockType>(TypeIdx);
+        OutSnapshot.OpaqueTypes[TypeIdx] = IsOpaqueBlockType(BlockType);
+        OutSnapshot.MeshedTypes[TypeIdx] = IsMeshedBlockType(BlockType);
+        if (BlockAtlasTiles.IsValidIndex(TypeIdx))
+        {
+            OutSnapshot.AtlasTiles[TypeIdx] = BlockAtlasTiles[TypeIdx];
+        }
     }
-    // Get old block type
-    EBlockType OldBlockType = GetBlockInternal(ChunkCoord, BlockPos);
-    // If the block type hasn't changed, do nothing
-    if (OldBlockType == BlockType)
-        return;
-    // Log ekleme
-    UE_LOG(LogTemp, Display, TEXT("SetBlockTypeAtPosition: %s pozisyonundaki %d blok tipi %d olarak değiştiriliyor"),
-        *WorldLocation.ToString(), static_cast<int32>(OldBlockType), static_cast<int32>(BlockType));
-    // Update block data on server
-    SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-    // Clear damage data if block is removed or changed
-    FWorldBlockKey Key(ChunkCoord, BlockPos);
-    if (BlockType == EBlockType::Air || OldBlockType != BlockType)
+
+    const int32 PaddedSize = ChunkSize + 2;
+    OutSnapshot.PaddedBlocks.Init(EBlockType::Air, PaddedSize * PaddedSize * ChunkHeight);
+
+    auto CopyColumn = [&](const FChunkBlockStorage& Source, int32 SourceX, int32 SourceY, int32 TargetX, int32 TargetY)
     {
-        BlockDamageData.Remove(Key);
-        // Also clear from DestroyedBlocksProcessed map
-        DestroyedBlocksProcessed.Remove(Key);
-        // Temizle from ProcessedDestroyedBlocks
-        FString BlockKey = FString::Printf(TEXT("%d_%d_%d_%d_%d"),
-            ChunkCoord.X, ChunkCoord.Y,
-            BlockPos.X, BlockPos.Y, BlockPos.Z);
-        ProcessedDestroyedBlocks.Remove(BlockKey);
-    }
-    // Eski bloğu temizle - özellikle önemli!
-    if (OldBlockType != EBlockType::Air)
+        const int32 SourceStart = Source.GetBlockIndex(SourceX, SourceY, 0);
+        const int32 TargetStart = OutSnapshot.GetPaddedIndex(TargetX, TargetY, 0);
+        for (int32 Z = 0; Z < ChunkHeight; Z++)
+        {
+            OutSnapshot.PaddedBlocks[TargetStart + Z] = Source.GetBlockByIndex(SourceStart + Z);
+        }
+    };
+
+    // Uniform storage = tamamen Air, kopyalanacak bir şey yok
+    const FChunkBlockStorage& ChunkBlocks = ChunkInfo.Blocks;
+    if (ChunkBlocks.IsInitialized() && !ChunkBlocks.IsUniform())
     {
-        RemoveBlockInstance(ChunkCoord, BlockPos, OldBlockType);
+        for (int32 X = 0; X < ChunkSize; X++)
+        {
+            for (int32 Y = 0; Y < ChunkSize; Y++)
+            {
+                CopyColumn(ChunkBlocks, X, Y, X, Y);
+            }
+        }
     }
-    // Yeni bloğu ekle
-    if (BlockType != EBlockType::Air)
+
+    // 1 blokluk apron: 4 komşu chunk'ın bize bakan sütunları (köşeler yüz komşusu olmadığı için gerekmez)
+    static const int32 ApronDirections[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+    for (const int32* Dir : ApronDirections)
     {
-        UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
+        const FChunkInfo* NeighbourInfo = ChunksInfo.Find(FChunkCoord(ChunkCoord.X + Dir[0], ChunkCoord.Y + Dir[1]));
+        if (!NeighbourInfo || !NeighbourInfo->Blocks.IsInitialized() || NeighbourInfo->Blocks.IsUniform())
+            continue;
+
+        for (int32 I = 0; I < ChunkSize; I++)
+        {
+            const int32 SourceX = (Dir[0] == 0) ? I : (Dir[0] < 0 ? ChunkSize - 1 : 0);
+            const int32 SourceY = (Dir[1] == 0) ? I : (Dir[1] < 0 ? ChunkSize - 1 : 0);
+            const int32 TargetX = (Dir[0] == 0) ? I : (Dir[0] < 0 ? -1 : ChunkSize);
+            const int32 TargetY = (Dir[1] == 0) ? I : (Dir[1] < 0 ? -1 : ChunkSize);
+            CopyColumn(NeighbourInfo->Blocks, SourceX, SourceY, TargetX, TargetY);
+        }
     }
-    // Replicate to clients
-    MulticastUpdateBlock(ChunkCoord, BlockPos, BlockType);
 }
 
-EBlockType ARandomMapGenerator::GetBlockTypeAtPosition(const FVector& WorldLocation) const
+void ARandomMapGenerator::CommitChunkBuild(const FChunkBuildResult& Result)
 {
-    // Convert world position to chunk and block coordinates
-    FChunkCoord ChunkCoord = WorldToChunkCoord(WorldLocation);
-    FBlockPosition BlockPos = WorldToBlockPosition(WorldLocation);
-    // Ensure block position is valid
-    if (BlockPos.X < 0 || BlockPos.X >= ChunkSize ||
-        BlockPos.Y < 0 || BlockPos.Y >= ChunkSize ||
-        BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
+    const FChunkCoord ChunkCoord(Result.ChunkCoord.X, Result.ChunkCoord.Y);
+    FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+
+    // Snapshot alındıktan sonra chunk değişti ya da dünya yeniden üretildi - sonuç bayat
+    if (!ChunkInfo || ChunkInfo->PendingBuildVersion != Result.Version)
     {
-        return EBlockType::Air;
+        UE_LOG(LogTemp, VeryVerbose, TEXT("Discarding stale build %u of chunk (%d,%d)"),
+            Result.Version, ChunkCoord.X, ChunkCoord.Y);
+        return;
+    }
+
+    ChunkInfo->PendingBuildVersion = 0;
+    ChunkInfo->BuildCancelToken.Reset();
+
+    CommitChunkInstances(ChunkCoord, Result.InstanceBatches);
+    CommitChunkMesh(Result.ChunkCoord, Result.MeshBuffers);
+
+    if (GenerationStage == EWorldGenerationStage::ChunkBuilds)
+    {
+        AddGenerationProgress();
     }
-    return GetBlockInternal(ChunkCoord, BlockPos);
 }
 
-// *** UPDATED: CHUNK-BASED INSTANCE MANAGEMENT ***
-void ARandomMapGenerator::UpdateBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+void ARandomMapGenerator::CommitChunkInstances(const FChunkCoord& ChunkCoord, const TArray<FChunkInstanceBatch>& InstanceBatches)
 {
-    if (BlockType == EBlockType::Air) return;
-
-    // Chunk ISM'leri yoksa oluştur
     if (!ChunkISMSystem.Contains(ChunkCoord))
     {
+        if (InstanceBatches.Num() == 0)
+            return;
+
         InitializeChunkISMs(ChunkCoord);
     }
 
     FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
-    UInstancedStaticMeshComponent* ChunkISM = ChunkData.ChunkISMs.FindRef(BlockType);
 
-    if (!ChunkISM)
+    // Chunk'ın tüm instance'ları build sonucuyla değiştirilir.
+    // Build'de artık instance'ı olmayan tiplerin component'leri serbest bırakılır, diğerleri temizlenip yeniden doldurulur.
+    TArray<EBlockType> ExistingSlots;
+    ChunkData.ChunkISMs.GetKeys(ExistingSlots);
+
+    for (EBlockType Slot : ExistingSlots)
     {
-        UE_LOG(LogTemp, Error, TEXT("No chunk ISM found for block type %d in chunk (%d,%d)"),
-            (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
-        return;
+        ChunkData.InstanceCounts.FindOrAdd(Slot) = 0;
+
+        const bool bStillUsed = InstanceBatches.ContainsByPredicate([this, Slot](const FChunkInstanceBatch& Batch)
+        {
+            return GetChunkISMSlot(Batch.BlockType) == Slot && Batch.Transforms.Num() > 0;
+        });
+
+        if (!bStillUsed)
+        {
+            ReleaseChunkISMIfEmpty(ChunkCoord, ChunkData, Slot);
+        }
+        else if (UHierarchicalInstancedStaticMeshComponent* ChunkISM = ChunkData.ChunkISMs.FindRef(Slot))
+        {
+            ChunkISM->ClearInstances();
+        }
     }
+    ChunkData.InstanceKeys.Reset();
 
-    // World position hesapla
-    FVector WorldPosition = BlockToWorldPosition(ChunkCoord, BlockPos);
-    FTransform InstanceTransform = FTransform(FRotator::ZeroRotator, WorldPosition);
+    int32 TotalInstances = 0;
+    for (const FChunkInstanceBatch& Batch : InstanceBatches)
+    {
+        TotalInstances += Batch.Transforms.Num();
+    }
 
-    // Instance'ı ekle
-    int32 InstanceIndex = ChunkISM->AddInstance(InstanceTransform);
+    ChunkData.InstanceIndexMapping.Reset();
+    ChunkData.InstanceIndexMapping.Reserve(TotalInstances);
 
-    // Instance mapping'e ekle - FIXED: Combined key approach
-    FBlockTypePositionKey MappingKey(BlockType, BlockPos);
-    ChunkData.InstanceIndexMapping.Add(MappingKey, InstanceIndex);
-    ChunkData.InstanceCounts[BlockType]++;
+    // Blok tipi başına tek AddInstances çağrısı: HISM ağacı instance başına değil, bir kez güncellenir
+    for (const FChunkInstanceBatch& Batch : InstanceBatches)
+    {
+        if (Batch.Transforms.Num() == 0)
+            continue;
 
-    UE_LOG(LogTemp, VeryVerbose, TEXT("Added instance %d for block type %d at chunk (%d,%d) local pos (%d,%d,%d) world pos %s"),
-        InstanceIndex, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y,
-        BlockPos.X, BlockPos.Y, BlockPos.Z, *WorldPosition.ToString());
-}
+        UInstancedStaticMeshComponent* ChunkISM = GetOrCreateChunkISM(ChunkCoord, Batch.BlockType);
+        if (!ChunkISM)
+            continue;
 
-void ARandomMapGenerator::RemoveBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
-{
-    if (BlockType == EBlockType::Air) return;
+        TArray<int32> InstanceIndices = ChunkISM->AddInstances(Batch.Transforms, true);
 
-    if (!ChunkISMSystem.Contains(ChunkCoord))
-    {
-        UE_LOG(LogTemp, Warning, TEXT("No chunk ISM data for chunk (%d,%d) when trying to remove block"),
-            ChunkCoord.X, ChunkCoord.Y);
-        return;
-    }
+        // Shared modda birden fazla tip aynı component'e (ve aynı ters index dizisine) eklenir
+        const EBlockType Slot = GetChunkISMSlot(Batch.BlockType);
+        TArray<FBlockTypePositionKey>& InstanceKeys = ChunkData.InstanceKeys.FindOrAdd(Slot);
+        InstanceKeys.SetNum(ChunkISM->GetInstanceCount());
 
-    FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
-    UInstancedStaticMeshComponent* ChunkISM = ChunkData.ChunkISMs.FindRef(BlockType);
+        TArray<float> CustomData;
+        for (int32 i = 0; i < InstanceIndices.Num(); i++)
+        {
+            const FIntVector& LocalPos = Batch.LocalPositions[i];
+            const FBlockPosition BlockPos(LocalPos.X, LocalPos.Y, LocalPos.Z);
+            const FBlockTypePositionKey MappingKey(Batch.BlockType, BlockPos);
+            ChunkData.InstanceIndexMapping.Add(MappingKey, InstanceIndices[i]);
+            InstanceKeys[InstanceIndices[i]] = MappingKey;
 
-    if (!ChunkISM)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("No chunk ISM for block type %d in chunk (%d,%d)"),
-            (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
-        return;
-    }
+            if (Slot == EBlockType::Air)
+            {
+                FillSharedInstanceCustomData(ChunkCoord, BlockPos, Batch.BlockType, CustomData);
+                ChunkISM->SetCustomData(InstanceIndices[i], CustomData, false);
+            }
+        }
+        ChunkData.InstanceCounts[Slot] += InstanceIndices.Num();
 
-    // Instance mapping'den instance index'i bul - FIXED: Combined key approach
-    FBlockTypePositionKey MappingKey(BlockType, BlockPos);
-    int32* FoundInstanceIndex = ChunkData.InstanceIndexMapping.Find(MappingKey);
+        if (Slot == EBlockType::Air)
+        {
+            ChunkISM->MarkRenderStateDirty();
+        }
+    }
+}
 
-    if (!FoundInstanceIndex)
+void ARandomMapGenerator::CommitChunkMesh(const FIntPoint& ChunkCoord, const FChunkMeshBuffers& Buffers)
+{
+    if (Buffers.Vertices.Num() == 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Instance not found for block pos (%d,%d,%d) type %d in chunk (%d,%d)"),
-            BlockPos.X, BlockPos.Y, BlockPos.Z, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y);
-
-        // Debug: Mapping'deki tüm instance'ları listele
-        UE_LOG(LogTemp, Warning, TEXT("Available instances in chunk (%d,%d):"),
-            ChunkCoord.X, ChunkCoord.Y);
-        for (const auto& Pair : ChunkData.InstanceIndexMapping)
+        if (FChunk* ExistingChunk = Chunks.Find(ChunkCoord))
         {
-            if (Pair.Key.BlockType == BlockType)
+            if (ExistingChunk->Mesh)
             {
-                UE_LOG(LogTemp, Warning, TEXT("  Type %d Pos(%d,%d,%d) -> Instance %d"),
-                    (int32)Pair.Key.BlockType, Pair.Key.BlockPos.X, Pair.Key.BlockPos.Y, Pair.Key.BlockPos.Z, Pair.Value);
+                ExistingChunk->Mesh->ClearAllMeshSections();
             }
         }
         return;
     }
 
-    int32 InstanceIndexToRemove = *FoundInstanceIndex;
+    FChunk& Chunk = Chunks.FindOrAdd(ChunkCoord);
+    Chunk.bNeedsRebuild = false;
 
-    // Double-check: Instance'ın pozisyonu doğru mu?
-    FTransform InstanceTransform;
-    if (ChunkISM->GetInstanceTransform(InstanceIndexToRemove, InstanceTransform))
+    if (!Chunk.Mesh)
     {
-        FVector ExpectedWorldPos = BlockToWorldPosition(ChunkCoord, BlockPos);
-        float DistanceSq = FVector::DistSquared(InstanceTransform.GetLocation(), ExpectedWorldPos);
-
-        if (DistanceSq > 1.0f) // 1 unit tolerance
+        FString ComponentName = FString::Printf(TEXT("ChunkMesh_%d_%d"), ChunkCoord.X, ChunkCoord.Y);
+        Chunk.Mesh = NewObject<UProceduralMeshComponent>(this, FName(*ComponentName));
+        Chunk.Mesh->SetupAttachment(RootComponent);
+        Chunk.Mesh->bUseAsyncCooking = true;
+        Chunk.Mesh->RegisterComponent();
+        Chunk.Mesh->SetCollisionProfileName(TEXT("BlockAll"));
+        Chunk.Mesh->SetCanEverAffectNavigation(true);
+        Chunk.Mesh->bCastDynamicShadow = true;
+
+        if (ChunkMaterial)
         {
-            UE_LOG(LogTemp, Error, TEXT("Instance position mismatch! Expected: %s, Found: %s, Distance: %f"),
-                *ExpectedWorldPos.ToString(), *InstanceTransform.GetLocation().ToString(), FMath::Sqrt(DistanceSq));
+            Chunk.Mesh->SetMaterial(0, ChunkMaterial);
         }
     }
 
-    // Yeni:
-    if (SwapRemoveInstance(ChunkISM, ChunkData, MappingKey))
-    {
-        ChunkData.InstanceCounts[BlockType]--;
-    };
+    TArray<FVector2D> EmptyUVs;
+    TArray<FColor> EmptyColors;
+    Chunk.Mesh->CreateMeshSection(0, Buffers.Vertices, Buffers.Triangles, Buffers.Normals,
+        Buffers.UV0, Buffers.UV1, EmptyUVs, EmptyUVs, EmptyColors, Buffers.Tangents, bMergedMeshCollision);
 
-    UE_LOG(LogTemp, Display, TEXT("Successfully removed instance %d for block type %d at chunk (%d,%d) pos (%d,%d,%d)"),
-        InstanceIndexToRemove, (int32)BlockType, ChunkCoord.X, ChunkCoord.Y, BlockPos.X, BlockPos.Y, BlockPos.Z);
+    UE_LOG(LogTemp, VeryVerbose, TEXT("Chunk mesh (%d,%d) rebuilt: %d quads"),
+        ChunkCoord.X, ChunkCoord.Y, Buffers.Vertices.Num() / 4);
 }
 
 // *** NEW: UPDATE CHUNK INSTANCE INDICES ***
@@ -1703,27 +4971,17 @@ void ARandomMapGenerator::UpdateChunkInstanceIndicesAfterRemoval(const FChunkCoo
 
     FChunkISMData& ChunkData = ChunkISMSystem[ChunkCoord];
 
-    // Kaldırılan index'ten büyük olan tüm index'leri 1 azalt - FIXED: Combined key approach
-    int32 UpdatedCount = 0;
-    TArray<FBlockTypePositionKey> KeysToUpdate;
-    TArray<int32> NewIndices;
-
-    // Önce güncellenecek key'leri ve yeni index'leri topla
-    for (auto& Pair : ChunkData.InstanceIndexMapping)
-    {
-        if (Pair.Key.BlockType == BlockType && Pair.Value > RemovedIndex)
-        {
-            KeysToUpdate.Add(Pair.Key);
-            NewIndices.Add(Pair.Value - 1);
-        }
-    }
+    TArray<FBlockTypePositionKey>* InstanceKeys = ChunkData.InstanceKeys.Find(GetChunkISMSlot(BlockType));
+    if (!InstanceKeys || !InstanceKeys->IsValidIndex(RemovedIndex)) return;
 
-    // Sonra güncelle (iterator invalidation'ı önlemek için)
-    for (int32 i = 0; i < KeysToUpdate.Num(); i++)
+    // Kaldırılan index'ten sonraki instance'lar bir slot kayar - ters index sayesinde sadece o key'ler güncellenir
+    int32 UpdatedCount = 0;
+    for (int32 i = RemovedIndex + 1; i < InstanceKeys->Num(); i++)
     {
-        ChunkData.InstanceIndexMapping[KeysToUpdate[i]] = NewIndices[i];
+        ChunkData.InstanceIndexMapping[(*InstanceKeys)[i]] = i - 1;
         UpdatedCount++;
     }
+    InstanceKeys->RemoveAt(RemovedIndex);
 
     UE_LOG(LogTemp, VeryVerbose, TEXT("Updated %d instance indices after removing index %d in chunk (%d,%d) type %d"),
         UpdatedCount, RemovedIndex, ChunkCoord.X, ChunkCoord.Y, (int32)BlockType);
@@ -1759,20 +5017,29 @@ bool ARandomMapGenerator::FindNearestBlock(const FVector& StartLocation, EBlockT
 
             // Get chunk info
             const FChunkInfo* ChunkInfo = ChunksInfo.Find(SearchChunkCoord);
-            if (!ChunkInfo || !ChunkInfo->bIsGenerated)
+            if (!ChunkInfo || !ChunkInfo->bIsGenerated || !ChunkInfo->Blocks.IsInitialized())
+                continue;
+
+            const FChunkBlockStorage& ChunkBlocks = ChunkInfo->Blocks;
+
+            // Chunk tamamen Air ise veya palette'te aranan tip yoksa tüm chunk'ı atla
+            if (ChunkBlocks.IsUniform())
+                continue;
+            if (BlockType != EBlockType::ALL && !ChunkBlocks.MayContainBlockType(BlockType))
                 continue;
 
             ChunksChecked++;
 
-            // Search all blocks in chunk
+            // Search all blocks in chunk - Z en içte, storage sütun-öncelikli olduğu için bellek sıralı okunur
             for (int32 X = 0; X < ChunkSize; X++)
             {
                 for (int32 Y = 0; Y < ChunkSize; Y++)
                 {
+                    const int32 ColumnStart = ChunkBlocks.GetBlockIndex(X, Y, 0);
                     for (int32 Z = 0; Z < ChunkHeight; Z++)
                     {
                         FBlockPosition BlockPos(X, Y, Z);
-                        EBlockType CurrBlockType = GetBlockInternal(SearchChunkCoord, BlockPos);
+                        EBlockType CurrBlockType = ChunkBlocks.GetBlockByIndex(ColumnStart + Z);
                         BlocksChecked++;
 
                         // ÖNEMLİ DEĞİŞİKLİK: Kontrol ifadesi güncellendi
@@ -1871,79 +5138,237 @@ FVector ARandomMapGenerator::BlockToWorldPosition(const FChunkCoord& ChunkCoord,
     return FVector(WorldX, WorldY, WorldZ);
 }
 
-bool ARandomMapGenerator::IsChunkGenerated(const FChunkCoord& ChunkCoord) const
+bool ARandomMapGenerator::IsChunkGenerated(const FChunkCoord& ChunkCoord) const
+{
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    return ChunkInfo && ChunkInfo->bIsGenerated;
+}
+
+// *** NEW: COALESCED BLOCK DELTAS ***
+// Patlama ya da hızlı inşa onlarca blok değiştirir; blok başına reliable multicast yerine
+// chunk başına tek paket gider, client da chunk başına tek ISM güncellemesi yapar.
+
+void ARandomMapGenerator::QueueBlockDelta(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+{
+    if (!HasAuthority() || BlockPos.X < 0 || BlockPos.X >= ChunkSize ||
+        BlockPos.Y < 0 || BlockPos.Y >= ChunkSize || BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
+        return;
+
+    const int32 BlockIndex = (BlockPos.X * ChunkSize + BlockPos.Y) * ChunkHeight + BlockPos.Z;
+    PendingBlockDeltas.FindOrAdd(FIntPoint(ChunkCoord.X, ChunkCoord.Y)).Add(BlockIndex, BlockType);
+}
+
+void ARandomMapGenerator::FlushBlockDeltas()
+{
+    TMap<FIntPoint, TMap<int32, EBlockType>> Deltas = MoveTemp(PendingBlockDeltas);
+    PendingBlockDeltas.Reset();
+
+    for (const auto& ChunkPair : Deltas)
+    {
+        TArray<FChunkBlockDelta> ChunkDeltas;
+        ChunkDeltas.AddDefaulted();
+        ChunkDeltas.Last().ChunkCoord = ChunkPair.Key;
+        ChunkDeltas.Last().Changes.Reserve(FMath::Min(ChunkPair.Value.Num(), MaxBlockDeltaChangesPerRPC));
+
+        for (const auto& ChangePair : ChunkPair.Value)
+        {
+            if (ChunkDeltas.Last().Changes.Num() == MaxBlockDeltaChangesPerRPC)
+            {
+                ChunkDeltas.AddDefaulted();
+                ChunkDeltas.Last().ChunkCoord = ChunkPair.Key;
+            }
+            ChunkDeltas.Last().Changes.Add((static_cast<uint32>(ChangePair.Key) << 4) | (static_cast<uint8>(ChangePair.Value) & 15));
+        }
+
+        // Fast array: değişen item'lar bir sonraki net update'te delta olarak gider; değişen blok hasarsız başlar.
+        // Geç katılanlar ve relevancy listeyi zaten alır - journal/catch-up kaydı tutulmaz
+        if (bReplicateBlockEditsAsFastArray)
+        {
+            for (const auto& ChangePair : ChunkPair.Value)
+            {
+                SetReplicatedBlockEdit(ChunkPair.Key, ChangePair.Key, ChangePair.Value, 0, false);
+            }
+            continue;
+        }
+
+        // Edit journal: geç katılanlar ve chunk'a sonradan yaklaşanlar için (blok başına son tip).
+        // Blok listesi sınırı aşınca chunk'ın tamamı gönderilir - kayıt chunk başına sınırlı kalır
+        const uint32 Version = ++ChunkEditVersions.FindOrAdd(ChunkPair.Key);
+        if (!SnapshotEditChunks.Contains(ChunkPair.Key))
+        {
+            TMap<int32, EBlockType>& Edits = ChunkEdits.FindOrAdd(ChunkPair.Key);
+            Edits.Append(ChunkPair.Value);
+            if (Edits.Num() > MaxTrackedEditsPerChunk)
+            {
+                ChunkEdits.Remove(ChunkPair.Key);
+                SnapshotEditChunks.Add(ChunkPair.Key);
+            }
+        }
+
+        if (!bChunkRelevancy)
+        {
+            for (const FChunkBlockDelta& Delta : ChunkDeltas)
+            {
+                MulticastApplyBlockDelta(Delta);
+            }
+            continue;
+        }
+
+        // Chunk'ı görmeyen bağlantılara gönderilmez; sürüm farkı chunk ilgili olunca kapatılır
+        for (auto& SubscriberPair : ChunkSubscribers)
+        {
+            FChunkSubscriber& Subscriber = SubscriberPair.Value;
+            UBuildSystem* BuildSystem = Subscriber.BuildSystem.Get();
+            if (!BuildSystem || !Subscriber.SubscribedChunks.Contains(ChunkPair.Key))
+                continue;
+
+            for (const FChunkBlockDelta& Delta : ChunkDeltas)
+            {
+                BuildSystem->ClientApplyBlockDelta(Delta);
+            }
+            Subscriber.KnownVersions.Add(ChunkPair.Key, Version);
+        }
+    }
+}
+
+void ARandomMapGenerator::MulticastApplyBlockDelta_Implementation(const FChunkBlockDelta& Delta)
 {
-    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
-    return ChunkInfo && ChunkInfo->bIsGenerated;
+    ApplyBlockDelta(Delta);
 }
 
-void ARandomMapGenerator::MulticastUpdateBlock_Implementation(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
+void ARandomMapGenerator::ApplyBlockDelta(const FChunkBlockDelta& Delta)
 {
-    // Veri güncelleme
-    EBlockType OldBlockType = GetBlockInternal(ChunkCoord, BlockPos);
-    // Debug için blok konumu ve diğer bilgileri logla
-    FVector WorldPos = BlockToWorldPosition(ChunkCoord, BlockPos);
-    UE_LOG(LogTemp, Display, TEXT("%s: MulticastUpdateBlock - Position: %s (%d,%d,%d), OldType: %d, NewType: %d"),
-        HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"),
-        *WorldPos.ToString(), BlockPos.X, BlockPos.Y, BlockPos.Z,
-        static_cast<int32>(OldBlockType), static_cast<int32>(BlockType));
-    // Veri güncelleme
-    SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
-    // Client tarafında görsel güncelleme yapmalıyız
-    // NOT: Server tarafında ApplyDamageToBlock içerisinde görsel güncelleme ZATEN yapılmıştır
-    if (!HasAuthority())
+    // Server'da veri ve görseller değişiklik anında güncellendi
+    if (HasAuthority())
+        return;
+
+    // Yerel dünya henüz üretilmediyse üretim bitince uygulanır (yoksa üretim edit'leri ezer);
+    // journal bekleniyorsa ondan sonra (yoksa daha eski journal yeni edit'leri ezer)
+    if (!bHasGeneratedWorld || bIsGeneratingWorld || bAwaitingEditJournal)
     {
-        // Eski bloğun görsel instance'ını kaldır (Air değilse ve değiştiyse)
-        if (OldBlockType != EBlockType::Air && OldBlockType != BlockType)  // <- IF KOŞULU EKLENDİ
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CLIENT: Removing block instance at (%d,%d,%d) type: %d"),
-                BlockPos.X, BlockPos.Y, BlockPos.Z, static_cast<int32>(OldBlockType));
-            // Debug görselleştirme ekleyelim
-            DrawDebugBox(GetWorld(), WorldPos, FVector(BlockSize / 2.0f),
-                FQuat::Identity, FColor::Red, false, 3.0f);
-            RemoveBlockInstance(ChunkCoord, BlockPos, OldBlockType);
-        }
-        // Yeni bloğu ekle (Air değilse)
-        if (BlockType != EBlockType::Air)
+        // Sınırsız büyümesin: taşan delta'lar atılır, chunk hash kontrolü o chunk'ları resync eder
+        if (DeferredBlockDeltas.Num() < MaxDeferredBlockDeltas)
         {
-            UpdateBlockInstance(ChunkCoord, BlockPos, BlockType);
-            // Debug görselleştirme ekleyelim
-            DrawDebugBox(GetWorld(), WorldPos, FVector(BlockSize / 2.0f),
-                FQuat::Identity, FColor::Green, false, 3.0f);
+            DeferredBlockDeltas.Add(Delta);
         }
+        return;
     }
-    // Server ise basit bir debug görseli ekle ama işlem yapma (ApplyDamageToBlock zaten yaptı)
-    else
+
+    const FChunkCoord ChunkCoord(Delta.ChunkCoord.X, Delta.ChunkCoord.Y);
+    const int32 NumBlocks = ChunkSize * ChunkSize * ChunkHeight;
+    const bool bRebuildChunk = Delta.Changes.Num() >= BlockDeltaRebuildThreshold;
+
+    // Kenar henüz yerelde üretilmediyse önce üretilir - sonradan üretilse server'ın edit'lerini ezer
+    EnsureEdgeFeaturesForChunk(ChunkCoord);
+
+    struct FAppliedChange
     {
-        // Sadece görselleştirme amaçlı
-        if (BlockType != OldBlockType)
+        FBlockPosition BlockPos;
+        EBlockType OldBlockType;
+    };
+    TArray<FAppliedChange> AppliedChanges;
+    AppliedChanges.Reserve(Delta.Changes.Num());
+
+    // Önce tüm veri yazılır, görsel güncelleme en sonda bir kez
+    for (const uint32 Change : Delta.Changes)
+    {
+        const int32 BlockIndex = static_cast<int32>(Change >> 4);
+        if (BlockIndex >= NumBlocks)
+            continue;
+
+        const FBlockPosition BlockPos(BlockIndex / (ChunkSize * ChunkHeight), (BlockIndex / ChunkHeight) % ChunkSize, BlockIndex % ChunkHeight);
+        const EBlockType BlockType = static_cast<EBlockType>(Change & 15);
+        const EBlockType OldBlockType = GetBlockInternal(ChunkCoord, BlockPos);
+        if (OldBlockType == BlockType)
+            continue;
+
+        SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, BlockType);
+        BlockDamageData.Remove(FWorldBlockKey(ChunkCoord, BlockPos));
+        AppliedChanges.Add({ BlockPos, OldBlockType });
+    }
+
+    for (const FAppliedChange& Applied : AppliedChanges)
+    {
+        if (bRebuildChunk)
+        {
+            // Chunk (ve sınırdaysa komşusu) tek build ile yeniden oluşur - blok başına ISM işlemi yok
+            MarkChunkMeshDirty(ChunkCoord, Applied.BlockPos);
+        }
+        else
         {
-            DrawDebugBox(GetWorld(), WorldPos, FVector(BlockSize / 3.0f),
-                FQuat::Identity, FColor::Blue, false, 1.0f);
+            RefreshBlockInstancesAround(ChunkCoord, Applied.BlockPos, Applied.OldBlockType);
         }
     }
+
+    UE_LOG(LogTemp, Display, TEXT("CLIENT: Block delta for chunk (%d,%d) - %d changes, %d applied%s"),
+        ChunkCoord.X, ChunkCoord.Y, Delta.Changes.Num(), AppliedChanges.Num(), bRebuildChunk ? TEXT(", chunk rebuild") : TEXT(""));
+}
+
+FChunkInfo& ARandomMapGenerator::FindOrAddChunkInfo(const FChunkCoord& ChunkCoord)
+{
+    FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (!ChunkInfo)
+    {
+        // Mountain border gibi dünya dışı chunk'lar da burada oluşur (bIsGenerated = false kalır)
+        ChunkInfo = &ChunksInfo.Add(ChunkCoord, FChunkInfo(ChunkCoord));
+    }
+
+    if (!ChunkInfo->Blocks.IsInitialized())
+    {
+        ChunkInfo->Blocks.Initialize(ChunkSize, ChunkHeight);
+        ChunkInfo->SurfaceHeights.SetNumZeroed(ChunkSize * ChunkSize);
+    }
+
+    return *ChunkInfo;
 }
 
 void ARandomMapGenerator::SetBlockInternalWithoutReplication(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType)
 {
-    FWorldBlockKey Key(ChunkCoord, BlockPos);
-    if (BlockType == EBlockType::Air)
+    // Dikey sınırların dışı saklanamaz (chunk storage sabit boyutlu)
+    if (BlockPos.Z < 0 || BlockPos.Z >= ChunkHeight)
     {
-        // Remove block if it's air
-        BlocksData.Remove(Key);
+        return;
     }
-    else
+
+    // Streaming: henüz yüklenmemiş bir chunk'a yazılıyorsa önce arazisini üret (yoksa sonra üretilince yazılan ezilir)
+    if (bStreamWorld)
     {
-        // Set or override block
-        BlocksData.Add(Key, BlockType);
+        EnsureChunkGenerated(ChunkCoord);
+    }
+
+    // Var olmayan bir chunk'a Air yazmak için chunk oluşturmaya gerek yok
+    if (BlockType == EBlockType::Air && !ChunksInfo.Contains(ChunkCoord))
+    {
+        return;
+    }
+
+    FChunkInfo& ChunkInfo = FindOrAddChunkInfo(ChunkCoord);
+    if (ChunkInfo.Blocks.IsValidPosition(BlockPos.X, BlockPos.Y, BlockPos.Z))
+    {
+        const int32 BlockIndex = ChunkInfo.Blocks.GetBlockIndex(BlockPos.X, BlockPos.Y, BlockPos.Z);
+        const EBlockType OldBlockType = ChunkInfo.Blocks.GetBlockByIndex(BlockIndex);
+
+        ChunkInfo.Blocks.SetBlockByIndex(BlockIndex, BlockType);
+        UpdateSurfaceHeight(ChunkInfo, BlockPos, BlockType);
+
+        // Eski bloğun terimi çıkar, yenisi girer (XOR)
+        ChunkInfo.ContentHash ^= GetBlockHashTerm(BlockIndex, OldBlockType) ^ GetBlockHashTerm(BlockIndex, BlockType);
+        MarkChunkHashDirty(ChunkCoord);
+
+        // Seed'den tekrar üretilemez - streaming bu chunk'ı bırakmaz
+        ChunkInfo.bPinned = true;
     }
 }
 
 EBlockType ARandomMapGenerator::GetBlockInternal(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos) const
 {
-    FWorldBlockKey Key(ChunkCoord, BlockPos);
-    const EBlockType* BlockType = BlocksData.Find(Key);
-    return BlockType ? *BlockType : EBlockType::Air;
+    const FChunkInfo* ChunkInfo = ChunksInfo.Find(ChunkCoord);
+    if (!ChunkInfo || !ChunkInfo->Blocks.IsValidPosition(BlockPos.X, BlockPos.Y, BlockPos.Z))
+    {
+        return EBlockType::Air;
+    }
+
+    return ChunkInfo->Blocks.GetBlock(BlockPos.X, BlockPos.Y, BlockPos.Z);
 }
 
 // *** UPDATED DAMAGE SYSTEM WITH CHUNK-BASED ISM ***
@@ -2007,20 +5432,8 @@ bool ARandomMapGenerator::ApplyDamageToBlock(const FVector& WorldLocation, float
     FBlockDamageData* DamageData = BlockDamageData.Find(Key);
     if (!DamageData)
     {
-        // Bu blok için maks can değerini data table'dan al
-        float MaxHealth = 100.0f; // Varsayılan değer
-        if (BlockDataTable)
-        {
-            FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
-            FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
-            if (BlockDataRow)
-            {
-                MaxHealth = BlockDataRow->Durability;
-            }
-        }
-
-        // Yeni hasar verisi oluştur
-        BlockDamageData.Add(Key, FBlockDamageData(MaxHealth));
+        // Bu blok için maks can değerini data table'dan al - yeni hasar verisi oluştur
+        BlockDamageData.Add(Key, FBlockDamageData(GetBlockMaxHealth(BlockType)));
         DamageData = BlockDamageData.Find(Key);
     }
 
@@ -2052,8 +5465,14 @@ bool ARandomMapGenerator::ApplyDamageToBlock(const FVector& WorldLocation, float
     FString HealthText = FString::Printf(TEXT("%.1f / %.1f"), DamageData->CurrentHealth, DamageData->MaxHealth);
     DrawDebugString(GetWorld(), BlockWorldLocation + FVector(0, 0, 20), *HealthText, nullptr, FColor::White, 1.0f);
 
-    // İstemcilere hasar güncellemesini bildir - istemcilerdeki debug görselleştirmesi buradan gelecek
-    MulticastBlockDamaged(ChunkCoord, BlockPos, DamageData->CurrentHealth, DamageInstigator, DamageCauser, DamageType);
+    // İstemcilere hasar güncellemesini bildir - bloğun son can değeri bir sonraki gönderimde gider
+    if (DamageData->CurrentHealth > 0.0f)
+    {
+        QueueBlockDamageState(ChunkCoord, BlockPos, *DamageData);
+
+        // Shared ISM modunda hasar durumu instance custom data'sında
+        UpdateBlockDamageCustomData(ChunkCoord, BlockPos, BlockType);
+    }
 
     // Blok yok edildi mi değişkeni
     bool bIsBlockDestroyed = false;
@@ -2085,83 +5504,157 @@ bool ARandomMapGenerator::ApplyDamageToBlock(const FVector& WorldLocation, float
         DrawDebugBoxIfEnabled(EDebugCategory::BlockPlacement, BlockWorldLocation,
             FVector(BlockSize / 2.0f), FColor::Red);
 
-        // *** UPDATED: Use chunk-based ISM removal instead of global search ***
-        RemoveBlockInstance(ChunkCoord, BlockPos, BlockType);
-
         // Veri güncelleme
         SetBlockInternalWithoutReplication(ChunkCoord, BlockPos, EBlockType::Air);
         BlockDamageData.Remove(Key);
 
-        // CLIENT'LARA BİLDİR
-        MulticastUpdateBlock(ChunkCoord, BlockPos, EBlockType::Air);
+        // *** UPDATED: Chunk-based ISM removal + açığa çıkan gömülü komşulara instance ver ***
+        RefreshBlockInstancesAround(ChunkCoord, BlockPos, BlockType);
+
+        // CLIENT'LARA BİLDİR (tick sonunda chunk delta'sı olarak)
+        QueueBlockDelta(ChunkCoord, BlockPos, EBlockType::Air);
     }
 
     // Bloğun yok edilip edilmediğini dön
     return bIsBlockDestroyed;
 }
 
-void ARandomMapGenerator::MulticastBlockDamaged_Implementation(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, float NewHealth, AActor* DamageInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageType)
+float ARandomMapGenerator::GetBlockMaxHealth(EBlockType BlockType) const
 {
-    // Blok koordinatlarını oluştur
-    FWorldBlockKey Key(ChunkCoord, BlockPos);
-    // Blok tipini al
-    EBlockType BlockType = GetBlockInternal(ChunkCoord, BlockPos);
-    // Hava bloğuna hasar uygulamaya gerek yok
-    if (BlockType == EBlockType::Air)
+    float MaxHealth = 100.0f; // Varsayılan değer
+    if (BlockDataTable)
+    {
+        FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
+        FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
+        if (BlockDataRow)
+        {
+            MaxHealth = BlockDataRow->Durability;
+        }
+    }
+    return MaxHealth;
+}
+
+// *** NEW: QUANTIZED BLOCK DAMAGE STATE ***
+// Her vuruş için reliable float + 2 actor + damage type yerine, blok başına son can değeri
+// MaxHealth'in 1/255'i hassasiyetle chunk başına tek unreliable RPC ile gider.
+
+void ARandomMapGenerator::QueueBlockDamageState(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, const FBlockDamageData& DamageData)
+{
+    if (!HasAuthority() || DamageData.MaxHealth <= 0.0f)
         return;
-    // Blok dünya konumunu hesapla - debug için gerekli
-    FVector BlockWorldLocation = BlockToWorldPosition(ChunkCoord, BlockPos);
-    // ÖNEMLİ: OnBlockDestroyed olayını SADECE SERVER tarafında çağır
-    // Client tarafında ÇAĞIRMA
-    // Debug için client tarafında görselleştirme ekle
-    if (!HasAuthority()) // Sadece client tarafında
-    {
-        // Debug görselleştirme ekle
-        DrawDebugSphere(GetWorld(), BlockWorldLocation, 10.0f, 8, FColor::Yellow, false, 1.0f);
-        // Hasar durumunu gösteren metin
-        FString HealthText = FString::Printf(TEXT("%.1f / %.1f"), NewHealth, 100.0f);
-        DrawDebugString(GetWorld(), BlockWorldLocation + FVector(0, 0, 20), *HealthText, nullptr, FColor::White, 1.0f);
-        UE_LOG(LogTemp, Display, TEXT("CLIENT: Block damaged at %s, new health: %.1f"),
-            *BlockWorldLocation.ToString(), NewHealth);
-    }
-    // Hasar verisini güncelle
-    FBlockDamageData* DamageData = BlockDamageData.Find(Key);
-    if (!DamageData)
+
+    // Yaşayan blok asla 0 göstermez - 0 sadece yıkımda (block delta) olur
+    const float HealthAlpha = FMath::Clamp(DamageData.CurrentHealth / DamageData.MaxHealth, 0.0f, 1.0f);
+    const uint8 QuantizedHealth = static_cast<uint8>(FMath::Clamp(FMath::CeilToInt(HealthAlpha * 255.0f), 1, 255));
+
+    const int32 BlockIndex = (BlockPos.X * ChunkSize + BlockPos.Y) * ChunkHeight + BlockPos.Z;
+    PendingBlockDamageStates.FindOrAdd(FIntPoint(ChunkCoord.X, ChunkCoord.Y)).Add(BlockIndex, QuantizedHealth);
+}
+
+void ARandomMapGenerator::FlushBlockDamageStates()
+{
+    TMap<FIntPoint, TMap<int32, uint8>> DamageStates = MoveTemp(PendingBlockDamageStates);
+    PendingBlockDamageStates.Reset();
+
+    for (const auto& ChunkPair : DamageStates)
     {
-        // Yeni hasar verisi oluştur
-        float MaxHealth = 100.0f; // Default value
-        if (BlockDataTable)
+        FChunkBlockDamageState DamageState;
+        DamageState.ChunkCoord = ChunkPair.Key;
+        DamageState.Entries.Reserve(ChunkPair.Value.Num());
+
+        const FChunkCoord ChunkCoord(ChunkPair.Key.X, ChunkPair.Key.Y);
+        for (const auto& EntryPair : ChunkPair.Value)
         {
-            FString BlockTypeStr = UEnum::GetValueAsString(BlockType).Replace(TEXT("EBlockType::"), TEXT(""));
-            FBlockData* BlockDataRow = BlockDataTable->FindRow<FBlockData>(FName(*BlockTypeStr), TEXT(""));
-            if (BlockDataRow)
+            // Gönderimden önce yıkılan blok zaten block delta ile gitti
+            const int32 BlockIndex = EntryPair.Key;
+            const FBlockPosition BlockPos(BlockIndex / (ChunkSize * ChunkHeight), (BlockIndex / ChunkHeight) % ChunkSize, BlockIndex % ChunkHeight);
+            if (!BlockDamageData.Contains(FWorldBlockKey(ChunkCoord, BlockPos)))
+                continue;
+
+            DamageState.Entries.Add((static_cast<uint32>(BlockIndex) << 8) | EntryPair.Value);
+        }
+
+        if (DamageState.Entries.Num() == 0)
+            continue;
+
+        if (bReplicateBlockEditsAsFastArray)
+        {
+            for (const uint32 Entry : DamageState.Entries)
             {
-                MaxHealth = BlockDataRow->Durability;
+                SetReplicatedBlockEdit(ChunkPair.Key, static_cast<int32>(Entry >> 8), EBlockType::Air, static_cast<uint8>(Entry & 255), true);
+            }
+            continue;
+        }
+
+        if (!bChunkRelevancy)
+        {
+            MulticastBlockDamageState(DamageState);
+            continue;
+        }
+
+        // Hasar geçicidir - chunk'ı görmeyen bağlantılar için saklanmaz
+        for (auto& SubscriberPair : ChunkSubscribers)
+        {
+            UBuildSystem* BuildSystem = SubscriberPair.Value.BuildSystem.Get();
+            if (BuildSystem && SubscriberPair.Value.SubscribedChunks.Contains(ChunkPair.Key))
+            {
+                BuildSystem->ClientReceiveBlockDamageState(DamageState);
             }
         }
-        BlockDamageData.Add(Key, FBlockDamageData(MaxHealth));
-        DamageData = BlockDamageData.Find(Key);
     }
-    // Yeni can değerini ayarla
-    DamageData->CurrentHealth = NewHealth;
-    DamageData->LastDamageInstigator = DamageInstigator;
-    DamageData->LastDamageCauser = DamageCauser;
-    DamageData->LastDamageType = DamageType;
-    // Hasar delegatesi çağır - hem client hem de server'da çağrılabilir
-    float Damage = DamageData->MaxHealth - NewHealth; // Yaklaşık hasar miktarı
-    OnBlockDamaged.Broadcast(BlockWorldLocation, BlockType, GetItemNameForBlockType(BlockType), Damage, DamageInstigator, DamageCauser, DamageType);
-    // Blok sağlığı sıfır veya daha az ise, client tarafında görselleştirme ekle
-    // ama OnBlockDestroyed event'ini çağırma!
-    if (DamageData->CurrentHealth <= 0.0f && !HasAuthority())
-    {
-        // Sadece client tarafında görselleştirme
-        DrawDebugBox(GetWorld(), BlockWorldLocation, FVector(BlockSize / 2.0f),
-            FQuat::Identity, FColor::Red, false, 5.0f);
-        UE_LOG(LogTemp, Warning, TEXT("CLIENT: Block destroyed at %s (visual only, event on server)"),
-            *BlockWorldLocation.ToString());
-        // Hasar verisini temizle
-        BlockDamageData.Remove(Key);
+}
+
+void ARandomMapGenerator::MulticastBlockDamageState_Implementation(const FChunkBlockDamageState& DamageState)
+{
+    ApplyBlockDamageState(DamageState);
+}
+
+void ARandomMapGenerator::ApplyBlockDamageState(const FChunkBlockDamageState& DamageState)
+{
+    // Server hasarı ApplyDamageToBlock'ta uyguladı ve OnBlockDamaged'i orada yayınladı
+    if (HasAuthority())
+        return;
+
+    const FChunkCoord ChunkCoord(DamageState.ChunkCoord.X, DamageState.ChunkCoord.Y);
+    const int32 NumBlocks = ChunkSize * ChunkSize * ChunkHeight;
+
+    for (const uint32 Entry : DamageState.Entries)
+    {
+        const int32 BlockIndex = static_cast<int32>(Entry >> 8);
+        if (BlockIndex >= NumBlocks)
+            continue;
+
+        const FBlockPosition BlockPos(BlockIndex / (ChunkSize * ChunkHeight), (BlockIndex / ChunkHeight) % ChunkSize, BlockIndex % ChunkHeight);
+
+        // Hava bloğuna hasar uygulamaya gerek yok (yıkım önce gelmiş olabilir)
+        const EBlockType BlockType = GetBlockInternal(ChunkCoord, BlockPos);
+        if (BlockType == EBlockType::Air)
+            continue;
+
+        // Hasar verisini güncelle
+        const FWorldBlockKey Key(ChunkCoord, BlockPos);
+        FBlockDamageData* DamageData = BlockDamageData.Find(Key);
+        if (!DamageData)
+        {
+            DamageData = &BlockDamageData.Add(Key, FBlockDamageData(GetBlockMaxHealth(BlockType)));
+        }
+
+        const float NewHealth = DamageData->MaxHealth * static_cast<float>(Entry & 255) / 255.0f;
+        const float Damage = DamageData->CurrentHealth - NewHealth; // Yaklaşık hasar miktarı
+        DamageData->CurrentHealth = NewHealth;
+
+        // Shared ISM modunda hasar durumu instance custom data'sında
+        UpdateBlockDamageCustomData(ChunkCoord, BlockPos, BlockType);
+
+        // Hasar delegatesi - instigator/causer/damage type client'a gönderilmez
+        const FVector BlockWorldLocation = BlockToWorldPosition(ChunkCoord, BlockPos);
+        OnBlockDamaged.Broadcast(BlockWorldLocation, BlockType, GetItemNameForBlockType(BlockType), Damage, nullptr, nullptr, nullptr);
+
+        DrawDebugSphereIfEnabled(EDebugCategory::BlockPlacement, BlockWorldLocation, 10.0f, FColor::Yellow);
     }
+
+    UE_LOG(LogTemp, Verbose, TEXT("CLIENT: Damage state for chunk (%d,%d) - %d blocks"),
+        ChunkCoord.X, ChunkCoord.Y, DamageState.Entries.Num());
 }
 
 FName ARandomMapGenerator::GetItemNameForBlockType(EBlockType BlockType) const
@@ -2175,45 +5668,16 @@ FName ARandomMapGenerator::GetItemNameForBlockType(EBlockType BlockType) const
     return NAME_None;
 }
 
-void ARandomMapGenerator::SpawnBaseCore()
+void ARandomMapGenerator::FlattenBaseCoreArea()
 {
-    // Sadece server Base Core'u spawn etmeli!
-    if (!HasAuthority())
-    {
-        UE_LOG(LogTemp, Display, TEXT("Client: SpawnBaseCore - sadece server spawn edecek"));
-        return;
-    }
-
-    // Eğer zaten spawn edilmişse tekrar spawn etme
-    if (SpawnedBaseCore)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Base Core zaten spawn edilmiş!"));
-        return;
-    }
-
-    // Base Core BP kontrolü
-    if (!BaseCoreBP)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("BaseCoreBP belirlenmemiş! Base Core spawn edilemedi."));
-        return;
-    }
-
     // Haritanın ortasını hesapla
     int32 CenterChunkX = WorldSizeInChunks / 2;
     int32 CenterChunkY = WorldSizeInChunks / 2;
-    FChunkCoord CenterChunk(CenterChunkX, CenterChunkY);
 
     // Chunk'ın ortasındaki blok koordinatını hesapla
-    int32 CenterBlockX = ChunkSize / 2;
-    int32 CenterBlockY = ChunkSize / 2;
-
-    // Haritanın en yüksek noktasını bul
-    int32 CenterWorldX = CenterChunkX * ChunkSize + CenterBlockX;
-    int32 CenterWorldY = CenterChunkY * ChunkSize + CenterBlockY;
-    int32 TerrainHeight = GetTerrainHeight(CenterWorldX, CenterWorldY);
-
-    UE_LOG(LogTemp, Display, TEXT("Base Core spawn - Merkez: (%d,%d), Terrain Height: %d"),
-        CenterWorldX, CenterWorldY, TerrainHeight);
+    int32 CenterWorldX = CenterChunkX * ChunkSize + ChunkSize / 2;
+    int32 CenterWorldY = CenterChunkY * ChunkSize + ChunkSize / 2;
+    int32 TerrainHeight = GetCachedTerrainHeight(CenterWorldX, CenterWorldY);
 
     // Base Core alanını düzleştir ve temizle
     for (int32 OffsetX = -BaseCoreSize; OffsetX <= BaseCoreSize; OffsetX++)
@@ -2243,8 +5707,6 @@ void ARandomMapGenerator::SpawnBaseCore()
 
                 if (OldBlockType != EBlockType::Air)
                 {
-                    // Mevcut instance'ı kaldır
-                    RemoveBlockInstance(BlockChunk, BlockPos, OldBlockType);
                     // Veriyi temizle
                     SetBlockInternalWithoutReplication(BlockChunk, BlockPos, EBlockType::Air);
                 }
@@ -2277,12 +5739,66 @@ void ARandomMapGenerator::SpawnBaseCore()
                     }
 
                     SetBlockInternalWithoutReplication(BlockChunk, BlockPos, NewBlockType);
-                    UpdateBlockInstance(BlockChunk, BlockPos, NewBlockType);
                 }
             }
         }
     }
 
+    bBaseCoreAreaFlattened = true;
+
+    // Üretim dışında (Blueprint'ten) çağrıldıysa sadece voxel verisi değişti - chunk geometrisini yeniden oluştur
+    if (!bDeferBlockInstances)
+    {
+        BuildAllChunkInstances();
+    }
+}
+
+void ARandomMapGenerator::SpawnBaseCore()
+{
+    // Sadece server Base Core'u spawn etmeli!
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Display, TEXT("Client: SpawnBaseCore - sadece server spawn edecek"));
+        return;
+    }
+
+    // Eğer zaten spawn edilmişse tekrar spawn etme
+    if (SpawnedBaseCore)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Base Core zaten spawn edilmiş!"));
+        return;
+    }
+
+    // Base Core BP kontrolü
+    if (!BaseCoreBP)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BaseCoreBP belirlenmemiş! Base Core spawn edilemedi."));
+        return;
+    }
+
+    // Haritanın ortasını hesapla
+    int32 CenterChunkX = WorldSizeInChunks / 2;
+    int32 CenterChunkY = WorldSizeInChunks / 2;
+    FChunkCoord CenterChunk(CenterChunkX, CenterChunkY);
+
+    // Chunk'ın ortasındaki blok koordinatını hesapla
+    int32 CenterBlockX = ChunkSize / 2;
+    int32 CenterBlockY = ChunkSize / 2;
+
+    // Haritanın en yüksek noktasını bul
+    int32 CenterWorldX = CenterChunkX * ChunkSize + CenterBlockX;
+    int32 CenterWorldY = CenterChunkY * ChunkSize + CenterBlockY;
+    int32 TerrainHeight = GetCachedTerrainHeight(CenterWorldX, CenterWorldY);
+
+    UE_LOG(LogTemp, Display, TEXT("Base Core spawn - Merkez: (%d,%d), Terrain Height: %d"),
+        CenterWorldX, CenterWorldY, TerrainHeight);
+
+    // Pipeline dışında (Blueprint'ten) çağrıldıysa alan henüz düzleştirilmedi
+    if (!bBaseCoreAreaFlattened)
+    {
+        FlattenBaseCoreArea();
+    }
+
     // DÜZELTME: Base Core'un spawn konumunu doğru hesapla
     // En üst blok seviyesinin tam üzerine yerleştir
     FVector SpawnLocation = BlockToWorldPosition(CenterChunk, FBlockPosition(CenterBlockX, CenterBlockY, TerrainHeight - 1));
@@ -2392,16 +5908,18 @@ void ARandomMapGenerator::GenerateDebugWalls()
 
                         FBlockPosition InnerBlockPos(InnerLocalBlockX, InnerLocalBlockY, LocalBaseHeight + Z);
                         SetBlockInternalWithoutReplication(InnerBlockChunk, InnerBlockPos, EBlockType::Stone);
-                        UpdateBlockInstance(InnerBlockChunk, InnerBlockPos, EBlockType::Stone);
                     }
-
-                    // Görsel güncelleme
-                    UpdateBlockInstance(BlockChunk, BlockPos, EBlockType::Stone);
                 }
             }
         }
     }
 
+    // Üretim dışında (Blueprint'ten) çağrıldıysa sadece voxel verisi değişti - chunk geometrisini yeniden oluştur
+    if (!bDeferBlockInstances)
+    {
+        BuildAllChunkInstances();
+    }
+
     UE_LOG(LogTemp, Display, TEXT("Debug duvarları başarıyla oluşturuldu."));
 }
 
@@ -2450,10 +5968,10 @@ void ARandomMapGenerator::GenerateSpawnPoints()
     int32 BottomRightY = FMath::FloorToInt(WorldSizeBlocks - OffsetFromEdge);
 
     // Yükseklikleri hesapla
-    int32 TopLeftHeight = GetTerrainHeight(TopLeftX, TopLeftY);
-    int32 TopRightHeight = GetTerrainHeight(TopRightX, TopRightY);
-    int32 BottomLeftHeight = GetTerrainHeight(BottomLeftX, BottomLeftY);
-    int32 BottomRightHeight = GetTerrainHeight(BottomRightX, BottomRightY);
+    int32 TopLeftHeight = GetSurfaceHeight(TopLeftX, TopLeftY);
+    int32 TopRightHeight = GetSurfaceHeight(TopRightX, TopRightY);
+    int32 BottomLeftHeight = GetSurfaceHeight(BottomLeftX, BottomLeftY);
+    int32 BottomRightHeight = GetSurfaceHeight(BottomRightX, BottomRightY);
 
     // Debug görselleştirme konumları
     TArray<FVector> DebugLocations = {
@@ -2585,7 +6103,7 @@ TArray<FVector> ARandomMapGenerator::GetEnemySpawnLocationsInRadius(int32 Reques
         int32 BlockY = FMath::FloorToInt(Y / EffectiveBlockSize);
 
         // Yüksekliği al
-        int32 TerrainHeightBlock = GetTerrainHeight(BlockX, BlockY);
+        int32 TerrainHeightBlock = GetSurfaceHeight(BlockX, BlockY);
         float Z = (TerrainHeightBlock + 1) * EffectiveBlockSize;
 
         SpawnLocations.Add(FVector(X, Y, Z));
@@ -2632,10 +6150,10 @@ TArray<FVector> ARandomMapGenerator::GenerateEnemySpawnPoints(int32 Count) const
         int32 BottomRightY = FMath::FloorToInt(WorldSizeBlocks - OffsetFromEdge);
 
         // Yükseklikleri hesapla
-        int32 TopLeftHeight = GetTerrainHeight(TopLeftX, TopLeftY);
-        int32 TopRightHeight = GetTerrainHeight(TopRightX, TopRightY);
-        int32 BottomLeftHeight = GetTerrainHeight(BottomLeftX, BottomLeftY);
-        int32 BottomRightHeight = GetTerrainHeight(BottomRightX, BottomRightY);
+        int32 TopLeftHeight = GetSurfaceHeight(TopLeftX, TopLeftY);
+        int32 TopRightHeight = GetSurfaceHeight(TopRightX, TopRightY);
+        int32 BottomLeftHeight = GetSurfaceHeight(BottomLeftX, BottomLeftY);
+        int32 BottomRightHeight = GetSurfaceHeight(BottomRightX, BottomRightY);
 
         // Köşe konumlarını diziye ekle
         CornerPositions.Add(FVector(
@@ -2701,7 +6219,7 @@ TArray<FVector> ARandomMapGenerator::GenerateEnemySpawnPoints(int32 Count) const
             BlockY = FMath::Clamp(BlockY, (int32)OffsetFromEdge, (int32)(WorldSizeBlocks - OffsetFromEdge));
 
             // Yüksekliği al
-            int32 TerrainHeightBlock = GetTerrainHeight(BlockX, BlockY);
+            int32 TerrainHeightBlock = GetSurfaceHeight(BlockX, BlockY);
 
             // Final koordinatları hesapla
             FVector SpawnLocation = FVector(
@@ -2747,7 +6265,7 @@ TArray<FVector> ARandomMapGenerator::GeneratePlayerSpawnPoints(int32 Count, floa
         int32 BlockY = FMath::FloorToInt(Y / EffectiveBlockSize);
 
         // Bu konumdaki arazi yüksekliğini al
-        int32 TerrainHeightBlock = GetTerrainHeight(BlockX, BlockY);
+        int32 TerrainHeightBlock = GetSurfaceHeight(BlockX, BlockY);
 
         // Z'yi arazinin hemen üzerine ayarla
         float Z = (TerrainHeightBlock + 1) * EffectiveBlockSize;
@@ -2765,9 +6283,17 @@ bool ARandomMapGenerator::SwapRemoveInstance(UInstancedStaticMeshComponent* Chun
     int32* FoundIndex = ChunkData.InstanceIndexMapping.Find(KeyToRemove);
     if (!FoundIndex) return false;
 
+    TArray<FBlockTypePositionKey>& InstanceKeys = ChunkData.InstanceKeys.FindOrAdd(GetChunkISMSlot(KeyToRemove.BlockType));
+
     int32 RemoveIndex = *FoundIndex;
     int32 LastIndex = ChunkISM->GetInstanceCount() - 1;
 
+    if (!ensureMsgf(InstanceKeys.Num() == LastIndex + 1 && InstanceKeys.IsValidIndex(RemoveIndex),
+        TEXT("Instance reverse index out of sync (%d keys, %d instances)"), InstanceKeys.Num(), LastIndex + 1))
+    {
+        return false;
+    }
+
     if (RemoveIndex != LastIndex)
     {
         // Son instance ile swap yap
@@ -2775,26 +6301,97 @@ bool ARandomMapGenerator::SwapRemoveInstance(UInstancedStaticMeshComponent* Chun
         ChunkISM->GetInstanceTransform(LastIndex, LastTransform, true);
         ChunkISM->UpdateInstanceTransform(RemoveIndex, LastTransform, true, true);
 
-        // Mapping'i düzelt
-        FBlockTypePositionKey LastKey;
-        for (auto& Pair : ChunkData.InstanceIndexMapping)
+        // Shared modda blok tipi/hasar custom data'da - son instance'ınkini de taşı
+        const int32 NumCustomData = ChunkISM->NumCustomDataFloats;
+        if (NumCustomData > 0 && ChunkISM->PerInstanceSMCustomData.Num() >= (LastIndex + 1) * NumCustomData)
         {
-            if (Pair.Value == LastIndex)
-            {
-                LastKey = Pair.Key;
-                break;
-            }
+            TArray<float> LastCustomData(&ChunkISM->PerInstanceSMCustomData[LastIndex * NumCustomData], NumCustomData);
+            ChunkISM->SetCustomData(RemoveIndex, LastCustomData, true);
         }
 
+        // Mapping'i düzelt - son instance'ın key'i ters index'ten O(1)
+        const FBlockTypePositionKey LastKey = InstanceKeys[LastIndex];
         ChunkData.InstanceIndexMapping[LastKey] = RemoveIndex;
+        InstanceKeys[RemoveIndex] = LastKey;
     }
 
     ChunkISM->RemoveInstance(LastIndex);
     ChunkData.InstanceIndexMapping.Remove(KeyToRemove);
+    InstanceKeys.Pop();
 
     return true;
 }
 
+// *** NEW: INSTANCE MAPPING CONSISTENCY CHECK ***
+bool ARandomMapGenerator::ValidateChunkInstanceMapping(const FChunkCoord& ChunkCoord) const
+{
+    const FChunkISMData* ChunkData = ChunkISMSystem.Find(ChunkCoord);
+    if (!ChunkData)
+        return true;
+
+    int32 ErrorCount = 0;
+
+    // Key -> index yönü: her key'in index'i ters index'te aynı key'i göstermeli
+    for (const auto& Pair : ChunkData->InstanceIndexMapping)
+    {
+        const TArray<FBlockTypePositionKey>* InstanceKeys = ChunkData->InstanceKeys.Find(GetChunkISMSlot(Pair.Key.BlockType));
+        if (!InstanceKeys || !InstanceKeys->IsValidIndex(Pair.Value) || !((*InstanceKeys)[Pair.Value] == Pair.Key))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Chunk (%d,%d): key type %d pos (%d,%d,%d) -> instance %d has no matching reverse entry"),
+                ChunkCoord.X, ChunkCoord.Y, (int32)Pair.Key.BlockType,
+                Pair.Key.BlockPos.X, Pair.Key.BlockPos.Y, Pair.Key.BlockPos.Z, Pair.Value);
+            ErrorCount++;
+        }
+    }
+
+    // Index -> key yönü: her slot mapping'de kendi index'ine dönmeli ve ISM instance sayısıyla eşleşmeli
+    for (const auto& KeysPair : ChunkData->InstanceKeys)
+    {
+        const TArray<FBlockTypePositionKey>& InstanceKeys = KeysPair.Value;
+
+        UInstancedStaticMeshComponent* ChunkISM = ChunkData->ChunkISMs.FindRef(KeysPair.Key);
+        const int32 ISMInstanceCount = ChunkISM ? ChunkISM->GetInstanceCount() : 0;
+        const int32* InstanceCount = ChunkData->InstanceCounts.Find(KeysPair.Key);
+
+        if (InstanceKeys.Num() != ISMInstanceCount || !InstanceCount || *InstanceCount != InstanceKeys.Num())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Chunk (%d,%d) type %d: %d reverse entries, %d ISM instances, InstanceCounts %d"),
+                ChunkCoord.X, ChunkCoord.Y, (int32)KeysPair.Key, InstanceKeys.Num(), ISMInstanceCount,
+                InstanceCount ? *InstanceCount : -1);
+            ErrorCount++;
+        }
+
+        for (int32 InstanceIndex = 0; InstanceIndex < InstanceKeys.Num(); InstanceIndex++)
+        {
+            const int32* MappedIndex = ChunkData->InstanceIndexMapping.Find(InstanceKeys[InstanceIndex]);
+            if (!MappedIndex || *MappedIndex != InstanceIndex)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Chunk (%d,%d) type %d: instance %d maps back to %d"),
+                    ChunkCoord.X, ChunkCoord.Y, (int32)KeysPair.Key, InstanceIndex, MappedIndex ? *MappedIndex : INDEX_NONE);
+                ErrorCount++;
+            }
+        }
+    }
+
+    return ErrorCount == 0;
+}
+
+bool ARandomMapGenerator::ValidateInstanceMappings() const
+{
+    int32 InvalidChunks = 0;
+    for (const auto& ChunkPair : ChunkISMSystem)
+    {
+        if (!ValidateChunkInstanceMapping(ChunkPair.Key))
+        {
+            InvalidChunks++;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Instance mapping validation: %d chunks checked, %d inconsistent"),
+        ChunkISMSystem.Num(), InvalidChunks);
+    return InvalidChunks == 0;
+}
+
 
 void ARandomMapGenerator::InitializeDebugSystem()
 {
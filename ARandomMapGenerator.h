@@ -3,8 +3,13 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Engine/DataTable.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/NetSerialization.h"
+#include "FChunkBlockStorage.h"
+#include "FChunkMeshBuilder.h"
+#include "FGenerationRandom.h"
 #include "ARandomMapGenerator.generated.h"
 
 UENUM(BlueprintType)
@@ -24,6 +29,17 @@ enum class EBlockType : uint8
     MAX
 };
 
+UENUM(BlueprintType)
+enum class EChunkRenderMode : uint8
+{
+    // One HISM per block type per chunk
+    InstancedMeshes,
+    // One greedy-meshed ProceduralMeshComponent per chunk for atlas (non-functional) blocks
+    MergedMesh,
+    // One HISM per chunk shared by all atlas blocks; block type (and damage) in PerInstanceCustomData
+    SharedInstancedMesh
+};
+
 USTRUCT(BlueprintType)
 struct FBlockData : public FTableRowBase
 {
@@ -85,6 +101,268 @@ struct FBlockDamageData
     FBlockDamageData(float InMax) : CurrentHealth(InMax), MaxHealth(InMax), LastDamageInstigator(nullptr), LastDamageCauser(nullptr), LastDamageType(nullptr) {}
 };
 
+// Block a generation feature (tree) places in another chunk than the one generating it, in the target chunk's local coordinates
+struct FFeatureBlockWrite
+{
+    FIntVector LocalPos;
+    EBlockType BlockType;
+};
+
+// Feature blocks one source chunk places in one target chunk
+struct FFeatureWriteBatch
+{
+    FIntPoint SourceChunk = FIntPoint::ZeroValue;
+    TArray<FFeatureBlockWrite> Writes;
+};
+
+/**
+ * Feature placement target of one generating chunk.
+ * Blocks in the chunk itself are written directly; blocks in other chunks are collected per target chunk
+ * and merged on the game thread, so chunks can place features in parallel without locking.
+ */
+struct FFeatureWriter
+{
+    FChunkCoord ChunkCoord;
+    FChunkBlockStorage& Blocks;
+    int32 ChunkSize;
+    TMap<FIntPoint, TArray<FFeatureBlockWrite>> OutgoingWrites;
+    // Runtime features (GenerateTree): own chunk blocks are collected too and applied as replicated edits
+    bool bCollectAllWrites = false;
+
+    FFeatureWriter(const FChunkCoord& InChunkCoord, FChunkBlockStorage& InBlocks, int32 InChunkSize)
+        : ChunkCoord(InChunkCoord), Blocks(InBlocks), ChunkSize(InChunkSize) {}
+
+    void SetBlock(int32 WorldX, int32 WorldY, int32 Z, EBlockType BlockType);
+
+    // Features only fill Air (and trunks replace leaves), so the result does not depend on the order features are merged in
+    static bool ApplyBlock(FChunkBlockStorage& Blocks, const FIntVector& LocalPos, EBlockType BlockType);
+};
+
+USTRUCT()
+struct FChunkInfo
+{
+    GENERATED_BODY()
+    UPROPERTY() FChunkCoord ChunkCoord;
+    UPROPERTY() bool bIsGenerated = false;
+
+    // Chunk'a ait tüm bloklar (dense, palette sıkıştırmalı) - replicate edilmez, seed'den üretilir
+    FChunkBlockStorage Blocks;
+
+    // Heightmap cache, indexed X * ChunkSize + Y (block counts, top block at height - 1)
+    // Generated ground height (empty for chunks that were never generated, e.g. mountain border chunks)
+    TArray<uint16> TerrainHeights;
+    // Current top solid block, kept up to date by SetBlockInternalWithoutReplication
+    TArray<uint16> SurfaceHeights;
+
+    // Written outside terrain generation (features, edits): cannot be regenerated from the seed, so streaming never unloads it
+    bool bPinned = false;
+
+    // Order independent hash of the block content (XOR of per block terms, Air contributes nothing), updated on every write
+    uint32 ContentHash = 0;
+
+    // Feature blocks merged in from neighbouring chunks, by source chunk; a source is merged at most once,
+    // and streaming hands them back to PendingFeatureWrites when the chunk is unloaded
+    TArray<FFeatureWriteBatch> IncomingFeatureWrites;
+
+    // Version of the last requested geometry build (0 = none pending); results with another version are stale
+    uint32 PendingBuildVersion = 0;
+    // Set when a newer build supersedes the one running on a worker thread
+    TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> BuildCancelToken;
+
+    FChunkInfo() {}
+    FChunkInfo(const FChunkCoord& InChunkCoord) : ChunkCoord(InChunkCoord) {}
+};
+
+USTRUCT()
+struct FChunkISMData
+{
+    GENERATED_BODY()
+    UPROPERTY() TMap<EBlockType, UHierarchicalInstancedStaticMeshComponent*> ChunkISMs;
+    // (type, local position) -> instance index in the ISM of that type
+    UPROPERTY() TMap<FBlockTypePositionKey, int32> InstanceIndexMapping;
+    UPROPERTY() TMap<EBlockType, int32> InstanceCounts;
+
+    // Reverse of InstanceIndexMapping: per type, slot i holds the key of instance i (swap-remove in O(1))
+    TMap<EBlockType, TArray<FBlockTypePositionKey>> InstanceKeys;
+};
+
+// Streaming load request, ordered by squared distance (chunk units) to the closest anchor
+struct FChunkStreamRequest
+{
+    FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    float DistanceSq = 0.f;
+
+    bool operator<(const FChunkStreamRequest& Other) const { return DistanceSq < Other.DistanceSq; }
+};
+
+// Stages of the world generation pipeline, in declaration order (see GenerationPipeline in the .cpp)
+UENUM(BlueprintType)
+enum class EWorldGenerationStage : uint8
+{
+    None,
+    // Terrain and trees of each chunk (chunk-local, parallel)
+    Chunks,
+    // Flattened base core area (voxels only, both server and client)
+    BaseCore,
+    MountainBorders,
+    // Cave tunnels, rocky formations and entrance seals; fills CaveLocations
+    Caves,
+    // Base core actor and debug spawn points (server only)
+    SpawnPoints,
+    DebugWalls,
+    // Visible instances / merged meshes of every chunk; generation completes when they are all committed
+    ChunkBuilds
+};
+
+// Chunk regions a generation stage reads or writes, used to derive stage dependencies
+namespace EGenerationRegion
+{
+    enum Type : uint8
+    {
+        None = 0,
+        MapInterior = 1 << 0,
+        // Chunks around the map center (base core, debug walls)
+        MapCenter = 1 << 1,
+        // Outermost ring of map chunks (mountain base heights, rocky formations)
+        MapEdge = 1 << 2,
+        // Chunks outside the map (mountains, caves)
+        Border = 1 << 3,
+        // Non-voxel generator state: spawned actors, CaveLocations
+        Actors = 1 << 4,
+        All = 0xFF
+    };
+}
+
+struct FWorldGenerationStageDesc
+{
+    EWorldGenerationStage Stage;
+    bool bRunsOnServer;
+    bool bRunsOnClient;
+    uint8 Reads;
+    uint8 Writes;
+};
+
+// Server content hash of one chunk, replicated so clients can find chunks that diverged from the server
+USTRUCT()
+struct FChunkContentHash
+{
+    GENERATED_BODY()
+    UPROPERTY() FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    UPROPERTY() uint32 Hash = 0;
+};
+
+// Block changes of one chunk during one server tick, sent to clients as a single multicast.
+// Each change is (local block index << 4) | EBlockType; a block changed twice in the tick keeps only its last type.
+USTRUCT()
+struct FChunkBlockDelta
+{
+    GENERATED_BODY()
+    UPROPERTY() FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    UPROPERTY() TArray<uint32> Changes;
+};
+
+// Latest damage state of the damaged blocks of one chunk, sent unreliably.
+// Each entry is (local block index << 8) | health quantized to 1..255 of the block's MaxHealth.
+USTRUCT()
+struct FChunkBlockDamageState
+{
+    GENERATED_BODY()
+    UPROPERTY() FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    UPROPERTY() TArray<uint32> Entries;
+};
+
+struct FReplicatedBlockEditArray;
+
+// One modified block in the replicated edit list (bReplicateBlockEditsAsFastArray)
+USTRUCT()
+struct FReplicatedBlockEdit : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    // Chunk X (16 bit) | chunk Y (16 bit) | local block index (32 bit), see PackBlockEditKey in the .cpp
+    UPROPERTY() uint64 BlockKey = 0;
+    UPROPERTY() uint8 BlockType = 0;
+    // 0 = no damage, otherwise health quantized to 1..255 of the block's MaxHealth
+    UPROPERTY() uint8 Health = 0;
+
+    void PostReplicatedAdd(const FReplicatedBlockEditArray& InArraySerializer);
+    void PostReplicatedChange(const FReplicatedBlockEditArray& InArraySerializer);
+};
+
+// Server's modified blocks; Unreal delta-serializes changed items, resends dropped ones and sends the whole list to late joiners
+USTRUCT()
+struct FReplicatedBlockEditArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY() TArray<FReplicatedBlockEdit> Items;
+
+    // Receives the client callbacks, set by the generator
+    class ARandomMapGenerator* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FReplicatedBlockEdit, FReplicatedBlockEditArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedBlockEditArray> : public TStructOpsTypeTraitsBase2<FReplicatedBlockEditArray>
+{
+    enum { WithNetDeltaSerializer = true };
+};
+
+// Server: chunk resyncs one connection requested in the current window (see ConsumeChunkResyncBudget)
+struct FChunkResyncBudget
+{
+    double WindowStart = 0.0;
+    int32 NumRequests = 0;
+};
+
+// Server: chunk interest of one remote connection (see UpdateChunkSubscriptions)
+struct FChunkSubscriber
+{
+    // Client-owned component block deltas and damage states are sent through
+    TWeakObjectPtr<class UBuildSystem> BuildSystem;
+    // Chunks within ChunkRelevancyRadius of the connection's view target
+    TSet<FIntPoint> SubscribedChunks;
+    // Edit version of each chunk the client last received; chunks behind ChunkEditVersions are caught up on subscribe
+    TMap<FIntPoint, uint32> KnownVersions;
+};
+
+// Server: edit journal being streamed to one late-joining client
+struct FEditJournalStream
+{
+    // Streams are keyed by controller - the pawn's component (BuildSystem) can die and be replaced mid-stream
+    TWeakObjectPtr<APlayerController> PlayerController;
+    // Component of the latest request; parts are sent through it
+    TWeakObjectPtr<class UBuildSystem> BuildSystem;
+    // Zlib-compressed journal, sent in EditJournalPartSize parts
+    TArray<uint8> CompressedData;
+    int32 UncompressedSize = 0;
+    int32 NumParts = 0;
+    int32 NextPart = 0;
+    int32 AckedParts = 0;
+};
+
+// Snapshot of the generated world for profiling and CI (see UWorldGenerationCommandlet)
+struct FWorldGenerationStats
+{
+    int32 NumChunks = 0;
+    int32 NumGeneratedChunks = 0;
+    // Indexed by EBlockType
+    int64 BlockCounts[16] = {};
+    // ISM instances (visible blocks not in a merged mesh) per chunk
+    TMap<FIntPoint, int32> InstancesPerChunk;
+    int64 TotalInstances = 0;
+    int64 MergedMeshTriangles = 0;
+    // Block storage, heightmaps and the chunk map itself
+    SIZE_T BlockDataBytes = 0;
+    // Hash of every block type in chunk coordinate order - identical worlds give identical hashes
+    uint64 ContentHash = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGenerationStageChanged, EWorldGenerationStage, Stage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_SevenParams(FOnBlockDamaged, const FVector&, Location, EBlockType, BlockType, FName, ItemName, float, Damage, AActor*, DamageInstigator, AActor*, DamageCauser, TSubclassOf<UDamageType>, DamageType);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_SevenParams(FOnBlockDestroyed, const FVector&, Location, EBlockType, BlockType, FName, ItemName, float, Damage, AActor*, DamageInstigator, AActor*, DamageCauser, TSubclassOf<UDamageType>, DamageType);
 
@@ -112,24 +390,95 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World") float HeightVariation = 5.f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World") float NoiseScale = 0.1f;
 
+    // Milliseconds of world generation work per tick (<= 0 generates the whole world in one tick)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World") float GenerationBudgetMs = 8.f;
+    // Generate chunk voxels (terrain + trees) with ParallelFor across all cores; border/base/cave features run afterwards on the game thread
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World") bool bParallelChunkFill = true;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blocks") UDataTable* BlockDataTable;
+    // Client: a block delta with at least this many changes rebuilds the chunk once instead of refreshing each block
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blocks") int32 BlockDeltaRebuildThreshold = 8;
+    // Replicate modified blocks as a fast array property instead of delta RPCs / edit journal (no chunk relevancy)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blocks") bool bReplicateBlockEditsAsFastArray = false;
+    // Server: damage of a block is sent at most once per interval, only its latest health (destruction goes out immediately)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Blocks") float BlockDamageSendInterval = 0.1f;
 
     // Atlas settings
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TextureAtlas") int32 AtlasCols = 3;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TextureAtlas") int32 AtlasRows = 2;
 
+    // === World streaming ===
+    // Only generate/show chunks near pawns and the base core instead of the whole WorldSizeInChunks grid
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming") bool bStreamWorld = false;
+    // Radii in chunks; unload radius > load radius gives hysteresis
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming") float StreamLoadRadius = 6.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming") float StreamUnloadRadius = 8.f;
+    // Seconds between anchor scans (chunk generation itself runs every tick within GenerationBudgetMs)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming") float StreamUpdateInterval = 0.25f;
+
+    // === Generated world cache ===
+    // Save the voxel result of the cacheable stages (terrain, base core flatten, border, caves) under Saved/<WorldCacheDirectory>
+    // and load it instead of regenerating when seed and generation settings match. Not used with bStreamWorld
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation Cache") bool bUseWorldCache = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation Cache") FString WorldCacheDirectory = TEXT("WorldCache");
+
+    // === World consistency ===
+    // Clients compare their chunk hashes with the server's this long after a change; a chunk must mismatch
+    // in two consecutive checks (so in-flight edits do not count) before it is resynced from the server
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Consistency") float ChunkHashVerifyDelay = 1.0f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Consistency") int32 MaxChunkResyncsPerCheck = 16;
+    // A resync the server dropped (rate limit, relevancy) is requested again after this long
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Consistency") float ChunkResyncTimeout = 5.0f;
+
+    // Block edits and damage only go to connections whose view target is near the chunk; others catch up on approach
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network Relevancy") bool bChunkRelevancy = true;
+    // In chunks
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network Relevancy") float ChunkRelevancyRadius = 4.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Network Relevancy") float ChunkRelevancyUpdateInterval = 0.5f;
+
+    // Late join: edits made before a client connected are streamed to it after it generated the world from the seed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Late Join") int32 EditJournalPartSize = 8192;
+    // Parts sent but not acknowledged yet, per client
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Late Join") int32 EditJournalWindowParts = 4;
+    // Upload budget shared by all journal streams
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Late Join") int32 EditJournalBytesPerSecond = 65536;
+    // Client: requests the journal again when no part arrived for this long (lost stream)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Late Join") float EditJournalTimeout = 10.f;
+
+    // === Chunk rendering ===
+    // MergedMesh: atlas blocks of a chunk are drawn as one greedy mesh; functional blocks and invisible walls stay on HISMs
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") EChunkRenderMode ChunkRenderMode = EChunkRenderMode::InstancedMeshes;
+    // Atlas material for merged chunk meshes (UV0 = atlas tile corners, UV1 = face size in blocks)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") UMaterialInterface* ChunkMaterial = nullptr;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bMergedMeshCollision = true;
+    // SharedInstancedMesh: cube mesh and texture-array material of the shared chunk HISM.
+    // The material gets <Type>_TopLayer/_SideLayer/_BottomLayer parameters and reads the type from custom data 0
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") UStaticMesh* SharedCubeMesh = nullptr;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") UMaterialInterface* SharedCubeMaterial = nullptr;
+    // Also write the damage ratio (0..1) to custom data 1
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bSharedMeshDamageCustomData = true;
+    // Emptied chunk ISM components kept registered for reuse (regeneration, streaming, edits); 0 destroys them instead
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") int32 MaxPooledChunkISMs = 4096;
+    // Build chunk geometry (visible instances + merged meshes) on worker threads; only the commit runs on the game thread
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bAsyncChunkBuilds = true;
+
     // Delegates
     UPROPERTY(BlueprintAssignable) FOnBlockDamaged OnBlockDamaged;
     UPROPERTY(BlueprintAssignable) FOnBlockDestroyed OnBlockDestroyed;
+    UPROPERTY(BlueprintAssignable) FOnGenerationStageChanged OnGenerationStageChanged;
 
     // === Functions ===
     UFUNCTION(BlueprintCallable) void GenerateWorld();
+    UFUNCTION(BlueprintPure) EWorldGenerationStage GetGenerationStage() const { return GenerationStage; }
+    // Wall time of each stage of the last generation in seconds (ChunkBuilds includes waiting for worker builds)
+    UFUNCTION(BlueprintPure) TMap<EWorldGenerationStage, float> GetGenerationStageTimes() const { return GenerationStageSeconds; }
     UFUNCTION(BlueprintCallable) void CreateChunk(const FIntPoint& Coord);
     UFUNCTION(BlueprintCallable) void RebuildChunk(const FIntPoint& ChunkCoord);
-    UFUNCTION(BlueprintCallable) void GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ, FChunk& Chunk);
+    UFUNCTION(BlueprintCallable) void GenerateTree(int32 WorldX, int32 WorldY, int32 WorldZ);
 
     UFUNCTION(BlueprintCallable) void GenerateMountainBorderSystem();
     UFUNCTION(BlueprintCallable) void GenerateCaveSystem();
+    void LogCaveSystemReport() const;
 
     UFUNCTION(BlueprintCallable) void SpawnBaseCore();
     UFUNCTION(BlueprintCallable) void GenerateSpawnPoints();
@@ -140,13 +489,56 @@ public:
     UFUNCTION(BlueprintCallable) void SetBlockTypeAtPosition(const FVector& WorldLocation, EBlockType BlockType);
     UFUNCTION(BlueprintCallable) EBlockType GetBlockTypeAtPosition(const FVector& WorldLocation) const;
 
+    // Debug: checks InstanceIndexMapping and its reverse index against each other and the ISM instance counts
+    UFUNCTION(BlueprintCallable, Category = "Debug") bool ValidateInstanceMappings() const;
+
+    // Debug: times FMath::PerlinNoise2D against the batched FTerrainNoise kernel and checks chunk heights match GetTerrainHeight
+    UFUNCTION(BlueprintCallable, Category = "Debug") void BenchmarkTerrainNoise(int32 Iterations = 10);
+
+    bool IsGeneratingWorld() const { return bIsGeneratingWorld; }
+
+    // Number of chunks this client had to resync from the server since the world was generated
+    UFUNCTION(BlueprintPure, Category = "Consistency") int32 GetNumChunkResyncs() const { return NumChunkResyncs; }
+    // Server: block data of a chunk for UBuildSystem::ClientReceiveChunkResync
+    bool GetChunkResyncData(const FIntPoint& ChunkCoord, TArray<uint8>& OutData);
+    // Server: false once the connection asked for more than MaxChunkResyncsPerCheck chunks within ChunkHashVerifyDelay
+    bool ConsumeChunkResyncBudget(class UBuildSystem* BuildSystem);
+    bool IsChunkInsideMap(const FChunkCoord& ChunkCoord) const;
+    // Client: replaces a chunk with the server's copy and rebuilds it
+    void ApplyChunkResync(const FIntPoint& ChunkCoord, const TArray<uint8>& Data);
+    void GatherWorldStatistics(FWorldGenerationStats& OutStats) const;
+
     UFUNCTION(BlueprintCallable) bool ApplyDamageToBlock(const FVector& WorldLocation, float Damage, AActor* EventInstigator = nullptr, AActor* DamageCauser = nullptr, TSubclassOf<UDamageType> DamageType = nullptr);
 
-    UFUNCTION(NetMulticast, Reliable) void MulticastBlockChanged(const FIntPoint& ChunkCoord, int32 X, int32 Y, int32 Z, EBlockType NewType);
-    UFUNCTION(NetMulticast, Reliable) void MulticastBlockDamaged(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, float NewHealth, AActor* DamageInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageType);
+    // All block changes of one chunk since the last flush (see QueueBlockDelta)
+    UFUNCTION(NetMulticast, Reliable) void MulticastApplyBlockDelta(const FChunkBlockDelta& Delta);
+    // Damage state of the blocks of one chunk hit since the last send (see QueueBlockDamageState)
+    UFUNCTION(NetMulticast, Unreliable) void MulticastBlockDamageState(const FChunkBlockDamageState& DamageState);
+
+    // Client: applies a block delta / damage state from the multicasts or from UBuildSystem (chunk relevancy)
+    void ApplyBlockDelta(const FChunkBlockDelta& Delta);
+    void ApplyBlockDamageState(const FChunkBlockDamageState& DamageState);
+    // Server: whether the connection of BuildSystem currently receives edits of the chunk
+    bool IsChunkRelevantTo(const class UBuildSystem* BuildSystem, const FIntPoint& ChunkCoord) const;
+
+    // Server: snapshots the edit journal and starts streaming it to BuildSystem's client
+    void BeginEditJournalStream(class UBuildSystem* BuildSystem);
+    void AckEditJournalPart(const class UBuildSystem* BuildSystem, int32 PartIndex);
+    // Client: one part of the journal; the last part decompresses and applies it
+    void ReceiveEditJournalPart(int32 PartIndex, int32 NumParts, int32 UncompressedSize, const TArray<uint8>& Data);
+
+    // Client: fast array callback - edits are applied per chunk on the next tick
+    void QueueReplicatedBlockEdit(const FReplicatedBlockEdit& Edit);
 
 protected:
     UPROPERTY() TMap<FIntPoint, FChunk> Chunks;
+
+    // Server chunk hashes, one entry per chunk
+    UPROPERTY(ReplicatedUsing = OnRep_ChunkHashes) TArray<FChunkContentHash> ChunkHashes;
+    UFUNCTION() void OnRep_ChunkHashes();
+
+    // Modified blocks (bReplicateBlockEditsAsFastArray)
+    UPROPERTY(Replicated) FReplicatedBlockEditArray ReplicatedBlockEdits;
     UPROPERTY() TMap<FWorldBlockKey, FBlockDamageData> BlockDamageData;
 
     void AddCubeFaces(TArray<FVector>& Vertices, TArray<int32>& Triangles, TArray<FVector2D>& UVs, FVector WorldPos, const FBlockData& Data);
@@ -154,4 +546,276 @@ protected:
 
     void ClearGeneratorState();
     float GetPerlinNoise(float X, float Y) const;
+
+    // Heights of every column of the chunk (X * ChunkSize + Y) with the batched noise kernel; equal to GetTerrainHeight per column
+    void GetChunkTerrainHeights(const FChunkCoord& ChunkCoord, int32 ChunkSeedModifier, TArray<int32>& OutHeights) const;
+    int32 ComposeTerrainHeight(int32 WorldX, int32 WorldY, int32 ChunkSeedModifier, float Noise, float SecondaryNoise) const;
+    static float CombineNoiseOctaves(float Noise1, float Noise2, float Noise3);
+    int32 GetChunkSeedModifier(const FChunkCoord& ChunkCoord) const;
+
+    // === Heightmap cache ===
+    // Ground height the chunk was generated with (generation stages); falls back to noise for chunks not generated yet
+    int32 GetCachedTerrainHeight(int32 WorldX, int32 WorldY) const;
+    // Height of the current top solid block (runtime spawn queries) - reflects placed and destroyed blocks
+    int32 GetSurfaceHeight(int32 WorldX, int32 WorldY) const;
+    static bool IsSurfaceBlockType(EBlockType BlockType);
+    bool GetColumnChunk(int32 WorldX, int32 WorldY, FChunkCoord& OutChunkCoord, int32& OutColumn) const;
+    void RebuildSurfaceHeights(FChunkInfo& ChunkInfo) const;
+    void UpdateSurfaceHeight(FChunkInfo& ChunkInfo, const FBlockPosition& BlockPos, EBlockType NewBlockType) const;
+
+    // Returns the chunk info for the coord, creating an empty (not generated) chunk with initialized storage if needed
+    FChunkInfo& FindOrAddChunkInfo(const FChunkCoord& ChunkCoord);
+
+    // === Hidden-face culling ===
+    // Only blocks with at least one non-opaque neighbour get an ISM instance
+    static bool IsOpaqueBlockType(EBlockType BlockType);
+    bool GetNeighbourBlockPosition(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, int32 OffsetX, int32 OffsetY, int32 OffsetZ, FChunkCoord& OutChunkCoord, FBlockPosition& OutBlockPos) const;
+    bool IsBlockExposed(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos) const;
+    bool NeedsBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType) const;
+    bool HasBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType) const;
+
+    // Adds/removes the instance of a single block so it matches its current exposure
+    void RefreshBlockInstance(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos);
+    // Call after a block changed: drops the old instance and refreshes the block and its 6 neighbours
+    void RefreshBlockInstancesAround(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType OldBlockType);
+
+    // Chunk ISM components are taken from the pool (or created) on a type's first instance and returned to it
+    // when its InstanceCounts entry drops to 0
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateChunkISM(const FChunkCoord& ChunkCoord, EBlockType BlockType);
+    void ReleaseChunkISMIfEmpty(const FChunkCoord& ChunkCoord, FChunkISMData& ChunkData, EBlockType BlockType);
+
+    // === Chunk ISM pool ===
+    // Pooled components stay registered with no instances; reuse prefers the same (chunk, slot), then any of the slot
+    UHierarchicalInstancedStaticMeshComponent* AcquirePooledChunkISM(const FChunkCoord& ChunkCoord, EBlockType Slot);
+    void ReleaseChunkISMToPool(const FChunkCoord& ChunkCoord, EBlockType Slot, UHierarchicalInstancedStaticMeshComponent* ChunkISM);
+    void ReleaseChunkISMs(const FChunkCoord& ChunkCoord, FChunkISMData& ChunkData);
+    // Mesh, material and collision of a chunk ISM - applied to new and reused components alike
+    void ConfigureChunkISM(UHierarchicalInstancedStaticMeshComponent* ChunkISM, EBlockType Slot, EBlockType BlockType);
+
+    // (chunk X, chunk Y, slot) -> pooled component
+    UPROPERTY() TMap<FIntVector, UHierarchicalInstancedStaticMeshComponent*> PooledChunkISMs;
+    // Per slot, keys in release order; stale keys (already reused) are skipped lazily
+    TMap<EBlockType, TArray<FIntVector>> PooledChunkISMKeys;
+
+    // Swap-with-last removal keeping InstanceIndexMapping and InstanceKeys in sync
+    bool SwapRemoveInstance(UInstancedStaticMeshComponent* ChunkISM, FChunkISMData& ChunkData, const FBlockTypePositionKey& KeyToRemove);
+    void UpdateChunkInstanceIndicesAfterRemoval(const FChunkCoord& ChunkCoord, EBlockType BlockType, int32 RemovedIndex);
+    bool ValidateChunkInstanceMapping(const FChunkCoord& ChunkCoord) const;
+
+    // Exposure pass after generation - queues a geometry build for every chunk
+    void BuildAllChunkInstances();
+
+    // True during world generation: generation stages only write voxel data, runtime instance refreshes are skipped
+    // and BuildAllChunkInstances fills every chunk's ISMs in bulk at the end
+    bool bDeferBlockInstances = false;
+
+    // === Merged (greedy) chunk meshes ===
+    void CacheBlockAtlasTiles();
+    bool IsMeshedBlockType(EBlockType BlockType) const;
+
+    // Queues the chunk (and neighbours sharing the block's faces) for a mesh rebuild on the next tick
+    void MarkChunkMeshDirty(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos);
+
+    TArray<FBlockAtlasTiles> BlockAtlasTiles;
+
+    // === Shared chunk ISM (SharedInstancedMesh) ===
+    bool IsSharedCubeBlockType(EBlockType BlockType) const;
+    // ChunkISMs/InstanceCounts/InstanceKeys key of a block type: EBlockType::Air for the shared component
+    EBlockType GetChunkISMSlot(EBlockType BlockType) const;
+    int32 GetSharedCustomDataFloats() const;
+    void InitializeSharedCubeMaterial();
+    void FillSharedInstanceCustomData(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType, TArray<float>& OutCustomData) const;
+    void UpdateBlockDamageCustomData(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType);
+
+    UPROPERTY() class UMaterialInstanceDynamic* SharedCubeMaterialInstance = nullptr;
+
+    // === Async chunk builds ===
+    // Queues a geometry build; supersedes (cancels) any build of the chunk that is still running
+    void RequestChunkBuild(const FChunkCoord& ChunkCoord);
+    bool IsChunkBuildPending(const FChunkCoord& ChunkCoord) const;
+    // Snapshots the queued chunks and dispatches their builds (or builds them inline if bAsyncChunkBuilds is off)
+    void FlushChunkBuildRequests();
+    void CreateChunkBuildSnapshot(const FChunkCoord& ChunkCoord, const FChunkInfo& ChunkInfo, FChunkBuildSnapshot& OutSnapshot) const;
+    // Game thread: applies a finished build unless the chunk changed since it was snapshotted
+    void CommitChunkBuild(const FChunkBuildResult& Result);
+    void CommitChunkInstances(const FChunkCoord& ChunkCoord, const TArray<FChunkInstanceBatch>& InstanceBatches);
+    void CommitChunkMesh(const FIntPoint& ChunkCoord, const FChunkMeshBuffers& Buffers);
+
+    // === Time-sliced generation ===
+    // Resets the progress counters, resolves stage dependencies and enters the first stage; Tick then runs AdvanceWorldGeneration
+    void StartWorldGenerationStages();
+    bool IsGenerationStageEnabled(const FWorldGenerationStageDesc& Desc) const;
+    // First enabled, unfinished stage whose dependencies have all finished
+    EWorldGenerationStage GetNextGenerationStage() const;
+    // Time slices of a feature stage (one per mountain edge / cave), each fits in GenerationBudgetMs on its own
+    int32 GetGenerationStageSteps(EWorldGenerationStage Stage) const;
+    void EnterGenerationStage(EWorldGenerationStage Stage);
+    // Records the wall time of the current stage and marks it finished
+    void CompleteGenerationStage();
+    void LogGenerationStageTimes() const;
+    // Flattens and fills the base core footprint at the map center; deterministic so clients run it too
+    void FlattenBaseCoreArea();
+
+    // === Generated world cache ===
+    // Hash of seed and every setting the cached stages read; part of the file name and checked against the file header
+    uint64 GetWorldCacheKey() const;
+    FString GetWorldCacheFilePath() const;
+    // Memory-maps the cache file (falls back to reading it) and fills ChunksInfo / CaveLocations; false if missing or invalid
+    bool LoadWorldCache();
+    // Serializes on the game thread, writes the file on a background thread
+    void SaveWorldCache();
+    bool bLoadedFromWorldCache = false;
+    bool bSavedWorldCache = false;
+
+    // === World consistency ===
+    static uint32 GetBlockHashTerm(int32 BlockIndex, EBlockType BlockType);
+    static uint32 ComputeChunkContentHash(const FChunkBlockStorage& Blocks);
+    // Server: chunks whose hash changed since ChunkHashes was last updated
+    void MarkChunkHashDirty(const FChunkCoord& ChunkCoord);
+    void PublishChunkHashes(bool bFull);
+    void ScheduleChunkHashVerification();
+    void VerifyChunkHashes();
+    class UBuildSystem* GetLocalBuildSystem() const;
+    static class UBuildSystem* GetBuildSystemForController(APlayerController* PlayerController);
+
+    TSet<FChunkCoord> DirtyChunkHashes;
+    TMap<FIntPoint, int32> ChunkHashIndices;
+    // Client: chunks that mismatched in the last check, with the server hash they were compared against
+    TMap<FIntPoint, uint32> SuspectChunkHashes;
+    // Server: resync request budget per requesting connection
+    TMap<TWeakObjectPtr<class UBuildSystem>, FChunkResyncBudget> ChunkResyncBudgets;
+    // Client: resyncs requested and not answered yet, with the time they were requested
+    TMap<FIntPoint, double> RequestedChunkResyncs;
+    double ChunkHashVerifyTime = 0.0;
+    int32 NumChunkResyncs = 0;
+
+    // === Block delta replication ===
+    // Server: block changes are coalesced per chunk and multicast once per tick instead of once per block
+    void QueueBlockDelta(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, EBlockType BlockType);
+    void FlushBlockDeltas();
+    // Chunk -> (local block index -> new type)
+    TMap<FIntPoint, TMap<int32, EBlockType>> PendingBlockDeltas;
+
+    // Server: quantized health of damaged blocks, merged per block until the next send
+    void QueueBlockDamageState(const FChunkCoord& ChunkCoord, const FBlockPosition& BlockPos, const FBlockDamageData& DamageData);
+    void FlushBlockDamageStates();
+    float GetBlockMaxHealth(EBlockType BlockType) const;
+    // Chunk -> (local block index -> quantized health)
+    TMap<FIntPoint, TMap<int32, uint8>> PendingBlockDamageStates;
+    float BlockDamageSendTimer = 0.f;
+
+    // === Chunk relevancy ===
+    void UpdateChunkSubscriptions();
+    // Sends every edit of the chunk so far to a client that subscribed with an older version
+    void SendChunkCatchUp(FChunkSubscriber& Subscriber, const FIntPoint& ChunkCoord);
+    bool IsChunkInRelevancyRadius(const FChunkCoord& CenterChunk, const FIntPoint& ChunkCoord) const;
+    TMap<TWeakObjectPtr<APlayerController>, FChunkSubscriber> ChunkSubscribers;
+    // Server: bumped on every flushed delta of the chunk
+    TMap<FIntPoint, uint32> ChunkEditVersions;
+    // Server: all edits of each chunk since generation (last type per block) - catch-up deltas
+    TMap<FIntPoint, TMap<int32, EBlockType>> ChunkEdits;
+    // Server: chunks with more edited blocks than MaxTrackedEditsPerChunk - catch-up and journal send the whole chunk
+    TSet<FIntPoint> SnapshotEditChunks;
+    float ChunkRelevancyTimer = 0.f;
+    // Client: deltas received before the local world finished generating (or before the edit journal was applied)
+    TArray<FChunkBlockDelta> DeferredBlockDeltas;
+
+    // === Late join edit journal ===
+    void PumpEditJournalStreams(float DeltaTime);
+    void ApplyEditJournal(const TArray<uint8>& JournalData);
+    TArray<FEditJournalStream> EditJournalStreams;
+    // Server: connections that received the whole journal of the current world - further requests are ignored
+    TSet<TWeakObjectPtr<APlayerController>> CompletedEditJournals;
+    static APlayerController* GetControllerForBuildSystem(class UBuildSystem* BuildSystem);
+    // Server: bytes the journal streams may still send (EditJournalBytesPerSecond, accumulated)
+    float EditJournalByteBudget = 0.f;
+    // Server: stream that is served first on the next pump (rotates so streams share the budget)
+    int32 EditJournalPumpStart = 0;
+    // Client: journal requested after generation and not applied yet - live deltas wait for it
+    bool bAwaitingEditJournal = false;
+    bool bEditJournalRequested = false;
+    // Client: component the journal was requested through and when a part last arrived (or the request was sent)
+    TWeakObjectPtr<class UBuildSystem> EditJournalRequester;
+    double EditJournalActivityTime = 0.0;
+    TArray<uint8> ReceivedEditJournal;
+    int32 ReceivedEditJournalParts = 0;
+
+    // === Fast array block edits ===
+    // Server: adds or updates the item of a block and marks it dirty
+    void SetReplicatedBlockEdit(const FIntPoint& ChunkCoord, int32 BlockIndex, EBlockType BlockType, uint8 Health, bool bKeepType);
+    void ApplyReplicatedBlockEdits();
+    // Server: BlockKey -> index in ReplicatedBlockEdits.Items
+    TMap<uint64, int32> ReplicatedBlockEditIndices;
+    // Client: latest received state per BlockKey, applied once the world is ready
+    TMap<uint64, FReplicatedBlockEdit> PendingReplicatedBlockEdits;
+
+    // Runs generation steps (one chunk or one whole feature stage each) until GenerationBudgetMs is used up
+    void AdvanceWorldGeneration();
+    void RunGenerationStep();
+    void AddGenerationProgress(int32 Steps = 1);
+
+    void GenerateChunksParallel(const TArray<FChunkCoord>& ChunkCoords);
+    // Pure function of seed, settings and chunk coord (randomness from FGenerationRandom) - safe on worker threads.
+    // Merges IncomingWrites queued by neighbours; feature blocks for other chunks end up in Writer.OutgoingWrites
+    void GenerateChunkBlocks(const FChunkCoord& ChunkCoord, FChunkInfo& ChunkInfo, const TArray<FFeatureWriteBatch>* IncomingWrites, FFeatureWriter& Writer) const;
+    // Places a tree rooted at the world column; leaves crossing into neighbouring chunks go through the writer
+    void PlaceTree(FFeatureWriter& Writer, int32 WorldX, int32 WorldY, int32 WorldZ) const;
+
+    // === Cross-chunk feature writes ===
+    // Game thread: merges a generated chunk's outgoing feature blocks into generated targets, queues the rest
+    void RouteFeatureWrites(const FChunkCoord& SourceChunk, TMap<FIntPoint, TArray<FFeatureBlockWrite>>& OutgoingWrites);
+    // Returns false if the target already has the source's blocks
+    static bool MergeFeatureWrites(FChunkInfo& ChunkInfo, const FFeatureWriteBatch& Batch);
+    // Feature blocks waiting for their (not yet generated) target chunk
+    TMap<FChunkCoord, TArray<FFeatureWriteBatch>> PendingFeatureWrites;
+
+    // === World streaming ===
+    // Chunks of the Chunks stage: the full grid, or in streaming mode the initial load radius sorted by distance
+    void BuildChunkGenerationOrder();
+    // Pawns (players and AI) and the base core, in chunk units
+    void GatherStreamingAnchors(TArray<FVector2D>& OutAnchors) const;
+    void UpdateWorldStreaming(float DeltaTime);
+    void RefreshStreamingQueue(const TArray<FVector2D>& Anchors);
+    // Generates queued chunks nearest first within GenerationBudgetMs
+    void ProcessStreamingQueue();
+    void UnloadDistantChunks(const TArray<FVector2D>& Anchors);
+    void UnloadChunk(const FChunkCoord& ChunkCoord);
+    // Generates the terrain of a map chunk that is about to be written to before it has been streamed in
+    void EnsureChunkGenerated(const FChunkCoord& ChunkCoord);
+    void RequestNeighbourChunkBuilds(const FChunkCoord& ChunkCoord);
+    // Mountain range + caves of one edge (edges do not overlap, so they can be generated lazily in any order)
+    void GenerateEdgeFeatures(int32 EdgeIndex);
+    void GenerateEdgeCaves(int32 EdgeIndex);
+    // Border chunks outside an edge and the map chunk row along it
+    bool IsChunkOnEdge(const FChunkCoord& ChunkCoord, int32 EdgeIndex) const;
+    // Streaming: generates the edges touching a chunk before an edit is written there (edge generation would overwrite it)
+    void EnsureEdgeFeaturesForChunk(const FChunkCoord& ChunkCoord);
+
+    TArray<FChunkCoord> ChunkGenerationOrder;
+    TArray<FChunkStreamRequest> StreamingQueue;
+    float StreamUpdateTimer = 0.f;
+    // Bit per edge whose mountain range and caves exist
+    uint8 GeneratedEdgeFeatures = 0;
+
+    EWorldGenerationStage GenerationStage = EWorldGenerationStage::None;
+    // Per stage bit masks (1 << stage) of the running pipeline
+    uint32 CompletedGenerationStages = 0;
+    TMap<EWorldGenerationStage, uint32> GenerationStageDependencies;
+    double GenerationStageStartTime = 0.0;
+    TMap<EWorldGenerationStage, float> GenerationStageSeconds;
+    bool bBaseCoreAreaFlattened = false;
+    int32 NextChunkToGenerate = 0;
+    // Step of the current feature stage (edge / cave index)
+    int32 GenerationStageStep = 0;
+    int32 GenerationStepsDone = 0;
+    int32 GenerationStepsTotal = 0;
+
+    // Generation completion events are held back until the initial chunk builds are committed
+    void FinishServerWorldGeneration();
+    void FinishClientWorldGeneration();
+
+    TSet<FIntPoint> PendingChunkBuilds;
+    int32 NumChunkBuildsInFlight = 0;
+    uint32 LastChunkBuildVersion = 0;
+    bool bAwaitingChunkBuilds = false;
 };
@@ -0,0 +1,168 @@
+﻿// FChunkBlockStorage.cpp - Palette-compressed chunk block storage
+#include "FChunkBlockStorage.h"
+#include "ARandomMapGenerator.h"
+
+void FChunkBlockStorage::Initialize(int32 InChunkSize, int32 InChunkHeight)
+{
+    ChunkSize = FMath::Max(0, InChunkSize);
+    ChunkHeight = FMath::Max(0, InChunkHeight);
+    BitsPerBlock = 0;
+
+    Palette.Reset();
+    Palette.Add(EBlockType::Air);
+    PackedIndices.Empty();
+}
+
+void FChunkBlockStorage::Reset()
+{
+    ChunkSize = 0;
+    ChunkHeight = 0;
+    BitsPerBlock = 0;
+
+    Palette.Empty();
+    PackedIndices.Empty();
+}
+
+void FChunkBlockStorage::SetBlockByIndex(int32 BlockIndex, EBlockType BlockType)
+{
+    checkSlow(BlockIndex >= 0 && BlockIndex < GetNumBlocks());
+
+    int32 PaletteIndex = Palette.IndexOfByKey(BlockType);
+    if (PaletteIndex == INDEX_NONE)
+    {
+        // EBlockType 4 bit'e sığar, palette asla 16 girişi geçemez
+        check(static_cast<uint8>(BlockType) < 16);
+        PaletteIndex = Palette.Add(BlockType);
+
+        const int32 RequiredBits = (PaletteIndex < 2) ? 1 : (PaletteIndex < 4) ? 2 : 4;
+        if (RequiredBits > BitsPerBlock)
+        {
+            Repack(RequiredBits);
+        }
+    }
+
+    // Uniform chunk and the same type written again - nothing to store
+    if (BitsPerBlock == 0)
+    {
+        return;
+    }
+
+    const int32 BitOffset = BlockIndex * BitsPerBlock;
+    const int32 Shift = BitOffset & 31;
+    const uint32 Mask = ((1u << BitsPerBlock) - 1) << Shift;
+
+    uint32& Word = PackedIndices[BitOffset >> 5];
+    Word = (Word & ~Mask) | (static_cast<uint32>(PaletteIndex) << Shift);
+}
+
+void FChunkBlockStorage::Repack(int32 NewBitsPerBlock)
+{
+    const int32 NumBlocks = GetNumBlocks();
+    const int32 NumWords = (NumBlocks * NewBitsPerBlock + 31) / 32;
+
+    TArray<uint32> NewIndices;
+    NewIndices.SetNumZeroed(NumWords);
+
+    // Bits 0 iken tüm bloklar palette[0] - yeni dizi zaten sıfır
+    if (BitsPerBlock > 0)
+    {
+        const uint32 OldMask = (1u << BitsPerBlock) - 1;
+        for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+        {
+            const int32 OldOffset = BlockIndex * BitsPerBlock;
+            const uint32 PaletteIndex = (PackedIndices[OldOffset >> 5] >> (OldOffset & 31)) & OldMask;
+
+            const int32 NewOffset = BlockIndex * NewBitsPerBlock;
+            NewIndices[NewOffset >> 5] |= PaletteIndex << (NewOffset & 31);
+        }
+    }
+
+    PackedIndices = MoveTemp(NewIndices);
+    BitsPerBlock = NewBitsPerBlock;
+}
+
+SIZE_T FChunkBlockStorage::GetAllocatedSize() const
+{
+    return Palette.GetAllocatedSize() + PackedIndices.GetAllocatedSize();
+}
+
+bool FChunkBlockStorage::Serialize(FArchive& Ar)
+{
+    Ar << ChunkSize;
+    Ar << ChunkHeight;
+    Ar << BitsPerBlock;
+
+    int32 PaletteNum = Palette.Num();
+    Ar << PaletteNum;
+
+    if (Ar.IsLoading())
+    {
+        // Bozuk / eski dosya ya da ağdan gelen veri - hiçbir şeyi okumadan reddet.
+        // Palette bit genişliğine sığmalı; tek girişten fazlası packed index ister.
+        // NumBlocks * BitsPerBlock int32'de taşmamalı.
+        const bool bValidHeader = !Ar.IsError() && ChunkSize > 0 && ChunkHeight > 0 &&
+            static_cast<int64>(ChunkSize) * ChunkSize * ChunkHeight <= MAX_int32 / 4 &&
+            PaletteNum >= 1 && PaletteNum <= 16 &&
+            (BitsPerBlock == 0 || BitsPerBlock == 1 || BitsPerBlock == 2 || BitsPerBlock == 4) &&
+            (BitsPerBlock > 0 || PaletteNum == 1) &&
+            PaletteNum <= (1 << BitsPerBlock);
+        if (!bValidHeader)
+        {
+            Ar.SetError();
+            Reset();
+            return false;
+        }
+        Palette.SetNumUninitialized(PaletteNum);
+    }
+
+    for (EBlockType& BlockType : Palette)
+    {
+        uint8 TypeValue = static_cast<uint8>(BlockType);
+        Ar << TypeValue;
+        if (TypeValue >= 16)
+        {
+            // EBlockType 4 bit'e sığar
+            Ar.SetError();
+        }
+        BlockType = static_cast<EBlockType>(TypeValue);
+    }
+
+    // Initialize her zaman Air ile başlar; uniform chunk'lar dahil palette[0] Air'dir
+    if (Ar.IsLoading() && !Ar.IsError() && Palette[0] != EBlockType::Air)
+    {
+        Ar.SetError();
+    }
+
+    PackedIndices.BulkSerialize(Ar);
+
+    if (Ar.IsLoading())
+    {
+        const int32 ExpectedWords = BitsPerBlock > 0 ? (GetNumBlocks() * BitsPerBlock + 31) / 32 : 0;
+        if (Ar.IsError() || PackedIndices.Num() != ExpectedWords)
+        {
+            Ar.SetError();
+            Reset();
+            return false;
+        }
+
+        // Her packed index palette içini göstermeli (GetBlockByIndex sınır kontrolü yapmaz)
+        if (BitsPerBlock > 0 && PaletteNum < (1 << BitsPerBlock))
+        {
+            const uint32 Mask = (1u << BitsPerBlock) - 1;
+            const int32 NumBlocks = GetNumBlocks();
+            for (int32 BlockIndex = 0; BlockIndex < NumBlocks; BlockIndex++)
+            {
+                const int32 BitOffset = BlockIndex * BitsPerBlock;
+                const uint32 PaletteIndex = (PackedIndices[BitOffset >> 5] >> (BitOffset & 31)) & Mask;
+                if (PaletteIndex >= static_cast<uint32>(PaletteNum))
+                {
+                    Ar.SetError();
+                    Reset();
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
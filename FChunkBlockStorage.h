@@ -0,0 +1,91 @@
+﻿// FChunkBlockStorage.h - Dense, palette-compressed block storage for a single chunk
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EBlockType : uint8;
+
+/**
+ * Dense block array for one chunk.
+ * Every block is stored as a bit-packed index into a small palette of block types. The palette always starts
+ * with Air, so an all-Air chunk (e.g. a freshly created border chunk) allocates no index memory at all;
+ * a chunk of any other single type (a solid mountain chunk) still needs 1 bit per block.
+ * A typical terrain chunk needs 2 bits per block and the worst case is 4 bits (EBlockType fits in a nibble).
+ * Layout is column-major (Z fastest) so vertical scans and column fills touch contiguous memory.
+ */
+struct BASEDEFENSE_API FChunkBlockStorage
+{
+public:
+    // Allocates an all-Air chunk of the given dimensions (drops any previous content)
+    void Initialize(int32 InChunkSize, int32 InChunkHeight);
+
+    // Releases all memory; the storage is unusable until Initialize is called again
+    void Reset();
+
+    FORCEINLINE bool IsInitialized() const { return Palette.Num() > 0; }
+
+    FORCEINLINE bool IsValidPosition(int32 X, int32 Y, int32 Z) const
+    {
+        return X >= 0 && X < ChunkSize && Y >= 0 && Y < ChunkSize && Z >= 0 && Z < ChunkHeight;
+    }
+
+    FORCEINLINE int32 GetBlockIndex(int32 X, int32 Y, int32 Z) const
+    {
+        return (X * ChunkSize + Y) * ChunkHeight + Z;
+    }
+
+    FORCEINLINE EBlockType GetBlockByIndex(int32 BlockIndex) const
+    {
+        if (BitsPerBlock == 0)
+        {
+            return Palette[0];
+        }
+
+        const int32 BitOffset = BlockIndex * BitsPerBlock;
+        const uint32 Word = PackedIndices[BitOffset >> 5];
+        return Palette[(Word >> (BitOffset & 31)) & ((1u << BitsPerBlock) - 1)];
+    }
+
+    FORCEINLINE EBlockType GetBlock(int32 X, int32 Y, int32 Z) const
+    {
+        return GetBlockByIndex(GetBlockIndex(X, Y, Z));
+    }
+
+    void SetBlockByIndex(int32 BlockIndex, EBlockType BlockType);
+
+    FORCEINLINE void SetBlock(int32 X, int32 Y, int32 Z, EBlockType BlockType)
+    {
+        SetBlockByIndex(GetBlockIndex(X, Y, Z), BlockType);
+    }
+
+    // Conservative filter: false means the chunk definitely has no block of this type
+    FORCEINLINE bool MayContainBlockType(EBlockType BlockType) const
+    {
+        return Palette.Contains(BlockType);
+    }
+
+    // True if no index array is allocated - every block is Air (palette[0])
+    FORCEINLINE bool IsUniform() const { return BitsPerBlock == 0; }
+
+    FORCEINLINE int32 GetChunkSize() const { return ChunkSize; }
+    FORCEINLINE int32 GetChunkHeight() const { return ChunkHeight; }
+    FORCEINLINE int32 GetNumBlocks() const { return ChunkSize * ChunkSize * ChunkHeight; }
+    FORCEINLINE int32 GetBitsPerBlock() const { return BitsPerBlock; }
+
+    SIZE_T GetAllocatedSize() const;
+
+    // Palette and packed indices exactly as stored in memory (world cache file).
+    // Returns false if loaded data is inconsistent; the storage is Reset in that case
+    bool Serialize(FArchive& Ar);
+
+private:
+    // Re-encodes all indices with a wider bit width (1, 2 or 4 bits)
+    void Repack(int32 NewBitsPerBlock);
+
+    int32 ChunkSize = 0;
+    int32 ChunkHeight = 0;
+    int32 BitsPerBlock = 0;
+
+    TArray<EBlockType, TInlineAllocator<16>> Palette;
+    TArray<uint32> PackedIndices;
+};
@@ -0,0 +1,311 @@
+﻿// FChunkMeshBuilder.cpp - Chunk geometry builder, runs on task graph workers
+#include "FChunkMeshBuilder.h"
+#include "ARandomMapGenerator.h"
+
+EBlockType FChunkBuildSnapshot::GetBlock(int32 LocalX, int32 LocalY, int32 Z) const
+{
+    // Dünyanın altı asla görünmez, üstü her zaman açık hava
+    if (Z < 0)
+        return EBlockType::Stone;
+    if (Z >= ChunkHeight)
+        return EBlockType::Air;
+
+    return PaddedBlocks[GetPaddedIndex(LocalX, LocalY, Z)];
+}
+
+bool FChunkMeshBuilder::Build(const FChunkBuildSnapshot& Snapshot, FChunkBuildResult& OutResult)
+{
+    OutResult.ChunkCoord = Snapshot.ChunkCoord;
+    OutResult.Version = Snapshot.Version;
+    OutResult.bHasMergedMesh = Snapshot.bBuildMergedMesh;
+    OutResult.InstanceBatches.Reset();
+    OutResult.MeshBuffers.Reset();
+
+    if (Snapshot.IsCancelled())
+        return false;
+
+    BuildInstances(Snapshot, OutResult);
+
+    if (Snapshot.bBuildMergedMesh)
+    {
+        if (!BuildGreedyMesh(Snapshot, OutResult.MeshBuffers))
+            return false;
+    }
+
+    return !Snapshot.IsCancelled();
+}
+
+FVector2D FChunkMeshBuilder::GetTileUV(const FVector2D& Tile, int32 CornerIndex, int32 AtlasCols, int32 AtlasRows)
+{
+    // Corner sırası: 0 = (0,0), 1 = (1,0), 2 = (1,1), 3 = (0,1)
+    const float CornerU = (CornerIndex == 1 || CornerIndex == 2) ? 1.0f : 0.0f;
+    const float CornerV = (CornerIndex == 2 || CornerIndex == 3) ? 1.0f : 0.0f;
+
+    const float TileWidth = 1.0f / FMath::Max(1, AtlasCols);
+    const float TileHeight = 1.0f / FMath::Max(1, AtlasRows);
+
+    return FVector2D((Tile.X + CornerU) * TileWidth, (Tile.Y + CornerV) * TileHeight);
+}
+
+void FChunkMeshBuilder::BuildInstances(const FChunkBuildSnapshot& Snapshot, FChunkBuildResult& OutResult)
+{
+    static const int32 NeighbourOffsets[6][3] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+
+    int32 BatchIndices[16];
+    for (int32& BatchIndex : BatchIndices)
+    {
+        BatchIndex = INDEX_NONE;
+    }
+
+    const float EffectiveBlockSize = Snapshot.BlockSize + Snapshot.BlockSpacing;
+    const float HalfBlockSize = Snapshot.BlockSize / 2.0f;
+    const int32 ChunkOriginX = Snapshot.ChunkCoord.X * Snapshot.ChunkSize;
+    const int32 ChunkOriginY = Snapshot.ChunkCoord.Y * Snapshot.ChunkSize;
+
+    for (int32 X = 0; X < Snapshot.ChunkSize; X++)
+    {
+        for (int32 Y = 0; Y < Snapshot.ChunkSize; Y++)
+        {
+            for (int32 Z = 0; Z < Snapshot.ChunkHeight; Z++)
+            {
+                const EBlockType BlockType = Snapshot.GetBlock(X, Y, Z);
+                if (BlockType == EBlockType::Air || Snapshot.IsMeshed(BlockType))
+                    continue;
+
+                // Opak bloklar sadece en az bir komşusu opak değilse görünür
+                bool bVisible = !Snapshot.IsOpaque(BlockType);
+                for (int32 Dir = 0; Dir < 6 && !bVisible; Dir++)
+                {
+                    const int32* Offset = NeighbourOffsets[Dir];
+                    bVisible = !Snapshot.IsOpaque(Snapshot.GetBlock(X + Offset[0], Y + Offset[1], Z + Offset[2]));
+                }
+
+                if (!bVisible)
+                    continue;
+
+                int32& BatchIndex = BatchIndices[static_cast<uint8>(BlockType) & 15];
+                if (BatchIndex == INDEX_NONE)
+                {
+                    BatchIndex = OutResult.InstanceBatches.AddDefaulted();
+                    OutResult.InstanceBatches[BatchIndex].BlockType = BlockType;
+                }
+
+                // ARandomMapGenerator::BlockToWorldPosition ile aynı konum
+                const FVector WorldPosition(
+                    (ChunkOriginX + X) * EffectiveBlockSize + HalfBlockSize,
+                    (ChunkOriginY + Y) * EffectiveBlockSize + HalfBlockSize,
+                    Z * EffectiveBlockSize + HalfBlockSize);
+
+                FChunkInstanceBatch& Batch = OutResult.InstanceBatches[BatchIndex];
+                Batch.LocalPositions.Add(FIntVector(X, Y, Z));
+                Batch.Transforms.Add(FTransform(FRotator::ZeroRotator, WorldPosition));
+            }
+        }
+    }
+}
+
+bool FChunkMeshBuilder::BuildGreedyMesh(const FChunkBuildSnapshot& Snapshot, FChunkMeshBuffers& OutBuffers)
+{
+    const int32 Dims[3] = { Snapshot.ChunkSize, Snapshot.ChunkSize, Snapshot.ChunkHeight };
+
+    TArray<EBlockType> Mask;
+
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        // Daha yeni bir build istendiyse bu sonucu tamamlamanın anlamı yok
+        if (Snapshot.IsCancelled())
+            return false;
+
+        const int32 U = (Axis + 1) % 3;
+        const int32 V = (Axis + 2) % 3;
+        Mask.SetNumUninitialized(Dims[U] * Dims[V]);
+
+        for (int32 Side = 0; Side < 2; Side++)
+        {
+            const bool bPositiveSide = (Side == 1);
+
+            for (int32 Slice = 0; Slice < Dims[Axis]; Slice++)
+            {
+                // 1. Bu dilimdeki görünür yüzlerin maskesi
+                int32 Pos[3];
+                int32 NeighbourPos[3];
+                Pos[Axis] = Slice;
+
+                for (int32 J = 0; J < Dims[V]; J++)
+                {
+                    for (int32 I = 0; I < Dims[U]; I++)
+                    {
+                        Pos[U] = I;
+                        Pos[V] = J;
+
+                        EBlockType BlockType = Snapshot.GetBlock(Pos[0], Pos[1], Pos[2]);
+                        EBlockType FaceType = EBlockType::Air;
+
+                        if (Snapshot.IsMeshed(BlockType))
+                        {
+                            NeighbourPos[0] = Pos[0];
+                            NeighbourPos[1] = Pos[1];
+                            NeighbourPos[2] = Pos[2];
+                            NeighbourPos[Axis] += bPositiveSide ? 1 : -1;
+
+                            // Aynı tip şeffaf bloklar (Leaves) arasındaki iç yüzler çizilmez
+                            EBlockType NeighbourType = Snapshot.GetBlock(NeighbourPos[0], NeighbourPos[1], NeighbourPos[2]);
+                            if (!Snapshot.IsOpaque(NeighbourType) && NeighbourType != BlockType)
+                            {
+                                FaceType = BlockType;
+                            }
+                        }
+
+                        Mask[I + J * Dims[U]] = FaceType;
+                    }
+                }
+
+                // 2. Greedy birleştirme: önce U yönünde genişlik, sonra V yönünde yükseklik
+                for (int32 J = 0; J < Dims[V]; J++)
+                {
+                    for (int32 I = 0; I < Dims[U];)
+                    {
+                        EBlockType FaceType = Mask[I + J * Dims[U]];
+                        if (FaceType == EBlockType::Air)
+                        {
+                            I++;
+                            continue;
+                        }
+
+                        int32 Width = 1;
+                        while (I + Width < Dims[U] && Mask[I + Width + J * Dims[U]] == FaceType)
+                        {
+                            Width++;
+                        }
+
+                        int32 Height = 1;
+                        bool bRowMatches = true;
+                        while (J + Height < Dims[V] && bRowMatches)
+                        {
+                            for (int32 K = 0; K < Width; K++)
+                            {
+                                if (Mask[I + K + (J + Height) * Dims[U]] != FaceType)
+                                {
+                                    bRowMatches = false;
+                                    break;
+                                }
+                            }
+
+                            if (bRowMatches)
+                            {
+                                Height++;
+                            }
+                        }
+
+                        AddGreedyQuad(Snapshot, OutBuffers, Axis, bPositiveSide, Slice, I, J, Width, Height, FaceType);
+
+                        // Kullanılan yüzleri maskeden temizle
+                        for (int32 H = 0; H < Height; H++)
+                        {
+                            for (int32 K = 0; K < Width; K++)
+                            {
+                                Mask[I + K + (J + H) * Dims[U]] = EBlockType::Air;
+                            }
+                        }
+
+                        I += Width;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void FChunkMeshBuilder::AddGreedyQuad(const FChunkBuildSnapshot& Snapshot, FChunkMeshBuffers& Buffers, int32 Axis, bool bPositiveSide,
+    int32 Slice, int32 U0, int32 V0, int32 Width, int32 Height, EBlockType BlockType)
+{
+    const int32 U = (Axis + 1) % 3;
+    const int32 V = (Axis + 2) % 3;
+    const float BlockSize = Snapshot.BlockSize;
+    const float EffectiveBlockSize = BlockSize + Snapshot.BlockSpacing;
+    const int32 ChunkOrigin[3] = { Snapshot.ChunkCoord.X * Snapshot.ChunkSize, Snapshot.ChunkCoord.Y * Snapshot.ChunkSize, 0 };
+
+    // Blok kenarı: blok küpü [Index * Effective, Index * Effective + BlockSize] aralığını kaplar
+    auto BlockEdge = [&](int32 AxisIndex, int32 LocalIndex, bool bMaxSide) -> float
+    {
+        return (ChunkOrigin[AxisIndex] + LocalIndex) * EffectiveBlockSize + (bMaxSide ? BlockSize : 0.0f);
+    };
+
+    const float Plane = BlockEdge(Axis, Slice, bPositiveSide);
+    const float UMin = BlockEdge(U, U0, false);
+    const float UMax = BlockEdge(U, U0 + Width - 1, true);
+    const float VMin = BlockEdge(V, V0, false);
+    const float VMax = BlockEdge(V, V0 + Height - 1, true);
+
+    // Köşeler: 0 = (UMin,VMin), 1 = (UMax,VMin), 2 = (UMax,VMax), 3 = (UMin,VMax)
+    const float CornerU[4] = { UMin, UMax, UMax, UMin };
+    const float CornerV[4] = { VMin, VMin, VMax, VMax };
+    const int32 CornerBlocksU[4] = { 0, Width, Width, 0 };
+    const int32 CornerBlocksV[4] = { 0, 0, Height, Height };
+
+    FVector Normal = FVector::ZeroVector;
+    Normal[Axis] = bPositiveSide ? 1.0f : -1.0f;
+
+    FVector TangentDir = FVector::ZeroVector;
+    TangentDir[U] = 1.0f;
+
+    // Yüz yönüne göre atlas tile'ı
+    const FBlockAtlasTiles& Tiles = Snapshot.AtlasTiles[static_cast<uint8>(BlockType) & 15];
+    const FVector2D& Tile = (Axis == 2) ? (bPositiveSide ? Tiles.TopTile : Tiles.BottomTile) : Tiles.SideTile;
+
+    const int32 BaseIndex = Buffers.Vertices.Num();
+
+    for (int32 Corner = 0; Corner < 4; Corner++)
+    {
+        FVector Vertex;
+        Vertex[Axis] = Plane;
+        Vertex[U] = CornerU[Corner];
+        Vertex[V] = CornerV[Corner];
+
+        // Doku koordinatı (blok biriminde): yan yüzlerde T ekseni yukarıdan aşağı (Z azalırken artar)
+        float S, T;
+        if (Axis == 2)
+        {
+            S = CornerBlocksU[Corner];
+            T = CornerBlocksV[Corner];
+        }
+        else if (Axis == 0) // U = Y, V = Z
+        {
+            S = CornerBlocksU[Corner];
+            T = Height - CornerBlocksV[Corner];
+        }
+        else // Axis == 1: U = Z, V = X
+        {
+            S = CornerBlocksV[Corner];
+            T = Width - CornerBlocksU[Corner];
+        }
+
+        const int32 TileCorner = (S > 0.0f) ? ((T > 0.0f) ? 2 : 1) : ((T > 0.0f) ? 3 : 0);
+
+        Buffers.Vertices.Add(Vertex);
+        Buffers.Normals.Add(Normal);
+        Buffers.UV0.Add(GetTileUV(Tile, TileCorner, Snapshot.AtlasCols, Snapshot.AtlasRows));
+        Buffers.UV1.Add(FVector2D(S, T));
+        Buffers.Tangents.Add(FProcMeshTangent(TangentDir, false));
+    }
+
+    // UE'de ön yüz üçgenlerinde Cross(B - A, C - A) normalin tersini gösterir
+    // (UKismetProceduralMeshLibrary::GenerateBoxMesh ile aynı sargı yönü)
+    const FVector& P0 = Buffers.Vertices[BaseIndex];
+    const FVector& P1 = Buffers.Vertices[BaseIndex + 1];
+    const FVector& P2 = Buffers.Vertices[BaseIndex + 2];
+    const bool bReverseWinding = FVector::DotProduct(FVector::CrossProduct(P1 - P0, P2 - P0), Normal) > 0.0f;
+
+    if (bReverseWinding)
+    {
+        Buffers.Triangles.Append({ BaseIndex, BaseIndex + 2, BaseIndex + 1, BaseIndex, BaseIndex + 3, BaseIndex + 2 });
+    }
+    else
+    {
+        Buffers.Triangles.Append({ BaseIndex, BaseIndex + 1, BaseIndex + 2, BaseIndex, BaseIndex + 2, BaseIndex + 3 });
+    }
+}
@@ -0,0 +1,119 @@
+﻿// FChunkMeshBuilder.h - Thread-safe chunk geometry builder (instance transforms + greedy merged mesh)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "HAL/ThreadSafeBool.h"
+
+enum class EBlockType : uint8;
+
+// Atlas tiles of a block type, cached from BlockDataTable for the chunk mesher and the shared ISM material
+struct FBlockAtlasTiles
+{
+    bool bMeshed = false;
+    FVector2D TopTile = FVector2D::ZeroVector;
+    FVector2D SideTile = FVector2D::ZeroVector;
+    FVector2D BottomTile = FVector2D::ZeroVector;
+};
+
+// Geometry of one merged chunk mesh section
+struct FChunkMeshBuffers
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    TArray<FVector> Normals;
+    TArray<FVector2D> UV0;      // Atlas UVs of the face tile (GetTileUV)
+    TArray<FVector2D> UV1;      // Face size in blocks - material tiles the atlas tile with frac(UV1)
+    TArray<FProcMeshTangent> Tangents;
+
+    void Reset()
+    {
+        Vertices.Reset();
+        Triangles.Reset();
+        Normals.Reset();
+        UV0.Reset();
+        UV1.Reset();
+        Tangents.Reset();
+    }
+};
+
+/**
+ * Immutable copy of everything a chunk build reads.
+ * Taken on the game thread; the worker never touches the generator or any UObject.
+ * Blocks are stored with a one block apron around X/Y so faces on the chunk border can be resolved.
+ */
+struct FChunkBuildSnapshot
+{
+    FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    int32 ChunkSize = 0;
+    int32 ChunkHeight = 0;
+    float BlockSize = 100.f;
+    float BlockSpacing = 0.f;
+    int32 AtlasCols = 1;
+    int32 AtlasRows = 1;
+
+    // Build the merged mesh (MergedMesh render mode) in addition to the instance lists
+    bool bBuildMergedMesh = false;
+
+    // Per block type flags, indexed by EBlockType
+    bool OpaqueTypes[16] = {};
+    bool MeshedTypes[16] = {};
+    FBlockAtlasTiles AtlasTiles[16];
+
+    // (ChunkSize + 2)^2 * ChunkHeight blocks, see GetPaddedIndex
+    TArray<EBlockType> PaddedBlocks;
+
+    // Version the result must match to be committed, and the token set when a newer build supersedes this one
+    uint32 Version = 0;
+    TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> CancelToken;
+
+    FORCEINLINE int32 GetPaddedIndex(int32 LocalX, int32 LocalY, int32 Z) const
+    {
+        return ((LocalX + 1) * (ChunkSize + 2) + (LocalY + 1)) * ChunkHeight + Z;
+    }
+
+    // Local X/Y may be -1..ChunkSize (apron); Z outside the column is resolved as world bottom/sky
+    EBlockType GetBlock(int32 LocalX, int32 LocalY, int32 Z) const;
+
+    FORCEINLINE bool IsOpaque(EBlockType BlockType) const { return OpaqueTypes[static_cast<uint8>(BlockType) & 15]; }
+    FORCEINLINE bool IsMeshed(EBlockType BlockType) const { return MeshedTypes[static_cast<uint8>(BlockType) & 15]; }
+    FORCEINLINE bool IsCancelled() const { return CancelToken.IsValid() && *CancelToken; }
+};
+
+// Instances of one block type in a chunk
+struct FChunkInstanceBatch
+{
+    EBlockType BlockType;
+    TArray<FIntVector> LocalPositions;
+    TArray<FTransform> Transforms;
+};
+
+struct FChunkBuildResult
+{
+    FIntPoint ChunkCoord = FIntPoint::ZeroValue;
+    uint32 Version = 0;
+    bool bHasMergedMesh = false;
+
+    TArray<FChunkInstanceBatch> InstanceBatches;
+    FChunkMeshBuffers MeshBuffers;
+};
+
+/**
+ * Pure chunk geometry builder. Safe to run on any thread.
+ */
+struct BASEDEFENSE_API FChunkMeshBuilder
+{
+    // Returns false if the snapshot was cancelled while building (result must be discarded)
+    static bool Build(const FChunkBuildSnapshot& Snapshot, FChunkBuildResult& OutResult);
+
+    static FVector2D GetTileUV(const FVector2D& Tile, int32 CornerIndex, int32 AtlasCols, int32 AtlasRows);
+
+private:
+    // Visible (exposed, non-meshed) blocks -> per type instance transforms
+    static void BuildInstances(const FChunkBuildSnapshot& Snapshot, FChunkBuildResult& OutResult);
+
+    // Greedy merging of coplanar same-type faces into quads
+    static bool BuildGreedyMesh(const FChunkBuildSnapshot& Snapshot, FChunkMeshBuffers& OutBuffers);
+    static void AddGreedyQuad(const FChunkBuildSnapshot& Snapshot, FChunkMeshBuffers& Buffers, int32 Axis, bool bPositiveSide,
+        int32 Slice, int32 U0, int32 V0, int32 Width, int32 Height, EBlockType BlockType);
+};
@@ -0,0 +1,68 @@
+﻿// FGenerationRandom.h - Stateless, counter-based random numbers for world generation
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Independent random sequences used by generation stages (never reorder - values are part of the world format)
+enum class EGenerationFeature : uint32
+{
+    TreePlacement = 1,
+    TreeShape = 2,
+};
+
+/**
+ * Counter-based RNG: the N-th value is a pure hash of (Seed, coordinate, feature, N).
+ * Unlike a shared FRandomStream the result does not depend on what was generated before, so chunks
+ * can be generated alone, in any order and on any thread and still match between server and client.
+ */
+struct FGenerationRandom
+{
+public:
+    FGenerationRandom(int32 Seed, const FIntPoint& Coord, EGenerationFeature Feature)
+        : Key(MakeKey(Seed, Coord, Feature))
+    {
+    }
+
+    // Random access: value of the given counter, does not advance the sequence
+    FORCEINLINE uint32 GetUInt(uint32 Index) const { return Combine(Key, Index); }
+    FORCEINLINE float GetFraction(uint32 Index) const { return (GetUInt(Index) >> 8) * (1.0f / 16777216.0f); }
+
+    // Sequential use (like FRandomStream): each call consumes the next counter
+    FORCEINLINE uint32 NextUInt() { return GetUInt(Counter++); }
+    FORCEINLINE float GetFraction() { return (NextUInt() >> 8) * (1.0f / 16777216.0f); }
+
+    // Inclusive range, same contract as FRandomStream::RandRange
+    FORCEINLINE int32 RandRange(int32 Min, int32 Max)
+    {
+        const uint64 Range = static_cast<uint64>(static_cast<int64>(Max) - Min + 1);
+        return Max <= Min ? Min : Min + static_cast<int32>((static_cast<uint64>(NextUInt()) * Range) >> 32);
+    }
+
+    static FORCEINLINE uint32 MakeKey(int32 Seed, const FIntPoint& Coord, EGenerationFeature Feature)
+    {
+        uint32 Hash = Mix(static_cast<uint32>(Seed));
+        Hash = Combine(Hash, static_cast<uint32>(Coord.X));
+        Hash = Combine(Hash, static_cast<uint32>(Coord.Y));
+        return Combine(Hash, static_cast<uint32>(Feature));
+    }
+
+private:
+    // 32 bit integer finalizer (good avalanche, cheap enough to call per block)
+    static FORCEINLINE uint32 Mix(uint32 Value)
+    {
+        Value ^= Value >> 16;
+        Value *= 0x7feb352dU;
+        Value ^= Value >> 15;
+        Value *= 0x846ca68bU;
+        Value ^= Value >> 16;
+        return Value;
+    }
+
+    static FORCEINLINE uint32 Combine(uint32 Hash, uint32 Value)
+    {
+        return Mix(Hash ^ (Value + 0x9e3779b9U + (Hash << 6) + (Hash >> 2)));
+    }
+
+    uint32 Key = 0;
+    uint32 Counter = 0;
+};
@@ -0,0 +1,158 @@
+﻿// FTerrainNoise.cpp - Batched (SIMD) 2D Perlin noise for terrain heights
+#include "FTerrainNoise.h"
+
+namespace TerrainNoise
+{
+    // Ken Perlin's reference permutation (same table as FMath::PerlinNoise2D)
+    static const uint8 Permutation[256] =
+    {
+        151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+        140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+        247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+        57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+        74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+        60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+        65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+        200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+        52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+        207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+        119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+        129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+        218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+        81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+        184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+        222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+    };
+
+    // Grad2 as coefficients: gradient(Hash) . (X, Y) = GradX * X + GradY * Y
+    static const float GradX[8] = { 1.f, 1.f, 0.f, -1.f, -1.f, -1.f, 0.f, 1.f };
+    static const float GradY[8] = { 0.f, 1.f, 1.f, 1.f, 0.f, -1.f, -1.f, -1.f };
+
+    FORCEINLINE int32 Perm(int32 Index)
+    {
+        return Permutation[Index & 255];
+    }
+
+    // Gradient hashes of the four cell corners (AA, BA, AB, BB)
+    FORCEINLINE void CornerHashes(float Xfl, float Yfl, int32 OutHashes[4])
+    {
+        const int32 Xi = static_cast<int32>(Xfl) & 255;
+        const int32 Yi = static_cast<int32>(Yfl) & 255;
+        const int32 AA = Perm(Xi) + Yi;
+        const int32 BA = Perm(Xi + 1) + Yi;
+        OutHashes[0] = Perm(AA) & 7;
+        OutHashes[1] = Perm(BA) & 7;
+        OutHashes[2] = Perm(AA + 1) & 7;
+        OutHashes[3] = Perm(BA + 1) & 7;
+    }
+
+    FORCEINLINE float SmoothCurve(float T)
+    {
+        return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+    }
+
+    FORCEINLINE float Lerp(float A, float B, float Alpha)
+    {
+        return A + Alpha * (B - A);
+    }
+
+    FORCEINLINE VectorRegister4Float VectorSmoothCurve(const VectorRegister4Float& T)
+    {
+        const VectorRegister4Float T3 = VectorMultiply(VectorMultiply(T, T), T);
+        const VectorRegister4Float Inner = VectorAdd(
+            VectorMultiply(T, VectorSubtract(VectorMultiply(T, VectorSetFloat1(6.0f)), VectorSetFloat1(15.0f))),
+            VectorSetFloat1(10.0f));
+        return VectorMultiply(T3, Inner);
+    }
+
+    FORCEINLINE VectorRegister4Float VectorLerp(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& Alpha)
+    {
+        return VectorAdd(A, VectorMultiply(Alpha, VectorSubtract(B, A)));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorGrad(const float* Gx, const float* Gy, const VectorRegister4Float& X, const VectorRegister4Float& Y)
+    {
+        return VectorAdd(VectorMultiply(VectorLoadAligned(Gx), X), VectorMultiply(VectorLoadAligned(Gy), Y));
+    }
+}
+
+float FTerrainNoise::Perlin2D(float X, float Y)
+{
+    using namespace TerrainNoise;
+
+    const float Xfl = FMath::FloorToFloat(X);
+    const float Yfl = FMath::FloorToFloat(Y);
+    const float Fx = X - Xfl;
+    const float Fy = Y - Yfl;
+    const float Fx1 = Fx - 1.0f;
+    const float Fy1 = Fy - 1.0f;
+
+    int32 Hashes[4];
+    CornerHashes(Xfl, Yfl, Hashes);
+
+    const float U = SmoothCurve(Fx);
+    const float V = SmoothCurve(Fy);
+
+    // Vector yolundaki işlem sırasıyla birebir aynı (bit-identical sonuç için)
+    const float G00 = GradX[Hashes[0]] * Fx + GradY[Hashes[0]] * Fy;
+    const float G10 = GradX[Hashes[1]] * Fx1 + GradY[Hashes[1]] * Fy;
+    const float G01 = GradX[Hashes[2]] * Fx + GradY[Hashes[2]] * Fy1;
+    const float G11 = GradX[Hashes[3]] * Fx1 + GradY[Hashes[3]] * Fy1;
+
+    return Lerp(Lerp(G00, G10, U), Lerp(G01, G11, U), V);
+}
+
+void FTerrainNoise::Perlin2DBatch(const float* X, const float* Y, float* Out, int32 Count)
+{
+    using namespace TerrainNoise;
+
+    const VectorRegister4Float One = VectorSetFloat1(1.0f);
+
+    int32 Index = 0;
+    for (; Index + 4 <= Count; Index += 4)
+    {
+        const VectorRegister4Float VX = VectorLoad(X + Index);
+        const VectorRegister4Float VY = VectorLoad(Y + Index);
+        const VectorRegister4Float Xfl = VectorFloor(VX);
+        const VectorRegister4Float Yfl = VectorFloor(VY);
+        const VectorRegister4Float Fx = VectorSubtract(VX, Xfl);
+        const VectorRegister4Float Fy = VectorSubtract(VY, Yfl);
+        const VectorRegister4Float Fx1 = VectorSubtract(Fx, One);
+        const VectorRegister4Float Fy1 = VectorSubtract(Fy, One);
+
+        // Permutation lookup'ları lane başına (SSE'de gather yok), geri kalan her şey 4'lü
+        alignas(16) float FloorX[4];
+        alignas(16) float FloorY[4];
+        VectorStoreAligned(Xfl, FloorX);
+        VectorStoreAligned(Yfl, FloorY);
+
+        alignas(16) float Gx[4][4];
+        alignas(16) float Gy[4][4];
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            int32 Hashes[4];
+            CornerHashes(FloorX[Lane], FloorY[Lane], Hashes);
+            for (int32 Corner = 0; Corner < 4; Corner++)
+            {
+                Gx[Corner][Lane] = GradX[Hashes[Corner]];
+                Gy[Corner][Lane] = GradY[Hashes[Corner]];
+            }
+        }
+
+        const VectorRegister4Float U = VectorSmoothCurve(Fx);
+        const VectorRegister4Float V = VectorSmoothCurve(Fy);
+
+        const VectorRegister4Float G00 = VectorGrad(Gx[0], Gy[0], Fx, Fy);
+        const VectorRegister4Float G10 = VectorGrad(Gx[1], Gy[1], Fx1, Fy);
+        const VectorRegister4Float G01 = VectorGrad(Gx[2], Gy[2], Fx, Fy1);
+        const VectorRegister4Float G11 = VectorGrad(Gx[3], Gy[3], Fx1, Fy1);
+
+        VectorStore(VectorLerp(VectorLerp(G00, G10, U), VectorLerp(G01, G11, U), V), Out + Index);
+    }
+
+    // Kalan (4'e bölünmeyen) örnekler
+    for (; Index < Count; Index++)
+    {
+        Out[Index] = Perlin2D(X[Index], Y[Index]);
+    }
+}
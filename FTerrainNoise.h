@@ -0,0 +1,19 @@
+﻿// FTerrainNoise.h - Batched (SIMD) 2D Perlin noise for terrain heights
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 2D Perlin noise with the permutation table and Grad2 gradients of FMath::PerlinNoise2D.
+ * Perlin2DBatch evaluates four samples per VectorRegister (SSE / NEON, FPU fallback when vector intrinsics are off)
+ * with the same operation order as the scalar Perlin2D, so chunk fills and single column queries give the same heights.
+ * Against FMath::PerlinNoise2D the difference is float rounding only (< 1e-6); ARandomMapGenerator::BenchmarkTerrainNoise
+ * measures both the speedup and the deviation.
+ */
+struct BASEDEFENSE_API FTerrainNoise
+{
+    static float Perlin2D(float X, float Y);
+
+    // Out[i] = Perlin2D(X[i], Y[i]) for i in [0, Count)
+    static void Perlin2DBatch(const float* X, const float* Y, float* Out, int32 Count);
+};
@@ -1506,4 +1506,89 @@ bool UBuildSystem::IsLocationBlockedByInvisibleWall(const FVector& Location)
 
     EBlockType BlockType = MapGenerator->GetBlockTypeAtPosition(Location);
     return (BlockType == EBlockType::InvisibleWall);
-}
\ No newline at end of file
+}
+
+bool UBuildSystem::ServerRequestChunkResync_Validate(const FIntPoint& ChunkCoord)
+{
+    // Client harita dışı (dağ sınırı) chunk'ları hiç istemez
+    return !MapGenerator.IsValid() || MapGenerator->IsChunkInsideMap(FChunkCoord(ChunkCoord.X, ChunkCoord.Y));
+}
+
+void UBuildSystem::ServerRequestChunkResync_Implementation(const FIntPoint& ChunkCoord)
+{
+    // Uzak chunk'ların edit'leri bilerek gönderilmiyor - onlar yaklaşınca catch-up ile gelir
+    if (!MapGenerator.IsValid() || !MapGenerator->IsChunkRelevantTo(this, ChunkCoord))
+        return;
+
+    // Bağlantı başına bütçe - her istek bir chunk serialize edip ~8 KB reliable cevap üretir
+    if (!MapGenerator->ConsumeChunkResyncBudget(this))
+        return;
+
+    TArray<uint8> BlockData;
+    if (MapGenerator->GetChunkResyncData(ChunkCoord, BlockData))
+    {
+        ClientReceiveChunkResync(ChunkCoord, BlockData);
+    }
+}
+
+void UBuildSystem::ClientReceiveChunkResync_Implementation(const FIntPoint& ChunkCoord, const TArray<uint8>& BlockData)
+{
+    if (MapGenerator.IsValid())
+    {
+        MapGenerator->ApplyChunkResync(ChunkCoord, BlockData);
+    }
+}
+
+void UBuildSystem::ClientApplyBlockDelta_Implementation(const FChunkBlockDelta& Delta)
+{
+    if (MapGenerator.IsValid())
+    {
+        MapGenerator->ApplyBlockDelta(Delta);
+    }
+}
+
+void UBuildSystem::ClientReceiveBlockDamageState_Implementation(const FChunkBlockDamageState& DamageState)
+{
+    if (MapGenerator.IsValid())
+    {
+        MapGenerator->ApplyBlockDamageState(DamageState);
+    }
+}
+
+bool UBuildSystem::ServerRequestEditJournal_Validate()
+{
+    // Tekrar istekler server'da sınırlı: bağlantı başına dünya üretimi başına tek snapshot, yarım akış baştan devam eder
+    return true;
+}
+
+void UBuildSystem::ServerRequestEditJournal_Implementation()
+{
+    if (MapGenerator.IsValid())
+    {
+        MapGenerator->BeginEditJournalStream(this);
+    }
+}
+
+void UBuildSystem::ClientReceiveEditJournalPart_Implementation(int32 PartIndex, int32 NumParts, int32 UncompressedSize, const TArray<uint8>& Data)
+{
+    if (!MapGenerator.IsValid())
+        return;
+
+    MapGenerator->ReceiveEditJournalPart(PartIndex, NumParts, UncompressedSize, Data);
+
+    // Server bir sonraki parçaları ancak onaydan sonra gönderir (akış kontrolü)
+    ServerAckEditJournalPart(PartIndex);
+}
+
+bool UBuildSystem::ServerAckEditJournalPart_Validate(int32 PartIndex)
+{
+    return PartIndex >= 0;
+}
+
+void UBuildSystem::ServerAckEditJournalPart_Implementation(int32 PartIndex)
+{
+    if (MapGenerator.IsValid())
+    {
+        MapGenerator->AckEditJournalPart(this, PartIndex);
+    }
+}
@@ -165,6 +165,30 @@ public:
     UFUNCTION(NetMulticast, Reliable)
     void MulticastSetFunctionalBlockTag(AActor* Actor);
 
+    // Client asks for the server's copy of a chunk whose content hash does not match (ARandomMapGenerator::VerifyChunkHashes)
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerRequestChunkResync(const FIntPoint& ChunkCoord);
+
+    UFUNCTION(Client, Reliable)
+    void ClientReceiveChunkResync(const FIntPoint& ChunkCoord, const TArray<uint8>& BlockData);
+
+    // Block edits and damage of the chunks near this connection's view target (ARandomMapGenerator chunk relevancy)
+    UFUNCTION(Client, Reliable)
+    void ClientApplyBlockDelta(const FChunkBlockDelta& Delta);
+
+    UFUNCTION(Client, Unreliable)
+    void ClientReceiveBlockDamageState(const FChunkBlockDamageState& DamageState);
+
+    // Late join: edits made before this client connected, streamed in acknowledged parts (ARandomMapGenerator edit journal)
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerRequestEditJournal();
+
+    UFUNCTION(Client, Reliable)
+    void ClientReceiveEditJournalPart(int32 PartIndex, int32 NumParts, int32 UncompressedSize, const TArray<uint8>& Data);
+
+    UFUNCTION(Server, Reliable, WithValidation)
+    void ServerAckEditJournalPart(int32 PartIndex);
+
     // *** YENİ FONKSİYON: INVISIBLE WALL DETECTION ***
     UFUNCTION(BlueprintCallable, Category = "Build System")
     bool IsLocationBlockedByInvisibleWall(const FVector& Location);
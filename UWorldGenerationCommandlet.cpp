@@ -0,0 +1,195 @@
+﻿// UWorldGenerationCommandlet.cpp - Headless world generation for profiling and CI
+#include "UWorldGenerationCommandlet.h"
+#include "ARandomMapGenerator.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "HAL/PlatformMemory.h"
+#include "Async/TaskGraphInterfaces.h"
+
+UWorldGenerationCommandlet::UWorldGenerationCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UWorldGenerationCommandlet::Main(const FString& Params)
+{
+    // Blueprint generator (block table, mesh ayarları) ya da native sınıf
+    UClass* GeneratorClass = ARandomMapGenerator::StaticClass();
+    FString GeneratorPath;
+    if (FParse::Value(*Params, TEXT("Generator="), GeneratorPath))
+    {
+        GeneratorClass = LoadClass<ARandomMapGenerator>(nullptr, *GeneratorPath);
+        if (!GeneratorClass)
+        {
+            UE_LOG(LogTemp, Error, TEXT("WorldGeneration: generator class %s could not be loaded"), *GeneratorPath);
+            return 1;
+        }
+    }
+
+    int32 Runs = 1;
+    FParse::Value(*Params, TEXT("Runs="), Runs);
+    Runs = FMath::Max(1, Runs);
+    const bool bPerChunk = FParse::Param(*Params, TEXT("PerChunk"));
+
+    // Oyuncusuz, render'sız geçici dünya (standalone - generator authority'dir)
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WorldGenerationCommandlet"));
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    // Ayarlar BeginPlay'den önce verilmeli (atlas tile cache, ISM init)
+    ARandomMapGenerator* Generator = World->SpawnActorDeferred<ARandomMapGenerator>(GeneratorClass, FTransform::Identity);
+    FParse::Value(*Params, TEXT("Seed="), Generator->Seed);
+    FParse::Value(*Params, TEXT("WorldSize="), Generator->WorldSizeInChunks);
+    FParse::Value(*Params, TEXT("ChunkSize="), Generator->ChunkSize);
+    FParse::Value(*Params, TEXT("ChunkHeight="), Generator->ChunkHeight);
+
+    // Varsayılan: tüm üretim tek seferde (time-slicing ölçümü bozmasın)
+    Generator->GenerationBudgetMs = 0.0f;
+    FParse::Value(*Params, TEXT("BudgetMs="), Generator->GenerationBudgetMs);
+
+    if (FParse::Param(*Params, TEXT("SyncBuilds")))
+    {
+        Generator->bAsyncChunkBuilds = false;
+    }
+
+    // Cache ölçülen işi atlatır
+    Generator->bUseWorldCache = false;
+    Generator->bStreamWorld = false;
+
+    Generator->FinishSpawning(FTransform::Identity);
+
+    UE_LOG(LogTemp, Display, TEXT("WorldGeneration: %s, seed %d, %dx%d chunks of %dx%dx%d, %d run(s)"),
+        *GeneratorClass->GetName(), Generator->Seed, Generator->WorldSizeInChunks, Generator->WorldSizeInChunks,
+        Generator->ChunkSize, Generator->ChunkSize, Generator->ChunkHeight, Runs);
+
+    TArray<FString> ReportLines;
+    double BestSeconds = DBL_MAX;
+    bool bSucceeded = true;
+
+    for (int32 RunIndex = 0; RunIndex < Runs && bSucceeded; RunIndex++)
+    {
+        double Seconds = 0.0;
+        bSucceeded = RunGeneration(Generator, Seconds);
+        if (bSucceeded)
+        {
+            BestSeconds = FMath::Min(BestSeconds, Seconds);
+            ReportStatistics(Generator, RunIndex, Seconds, bPerChunk && RunIndex == Runs - 1, ReportLines);
+        }
+    }
+
+    FWorldGenerationStats Stats;
+    Generator->GatherWorldStatistics(Stats);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+
+    if (!bSucceeded)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldGeneration: generation did not complete"));
+        return 1;
+    }
+
+    ReportLines.Add(FString::Printf(TEXT("best_ms=%.2f"), BestSeconds * 1000.0));
+
+    FString ReportPath;
+    if (FParse::Value(*Params, TEXT("Report="), ReportPath))
+    {
+        FFileHelper::SaveStringToFile(FString::Join(ReportLines, LINE_TERMINATOR) + LINE_TERMINATOR, *ReportPath);
+    }
+
+    // CI kapısı
+    int32 Result = 0;
+
+    FString ExpectedHash;
+    if (FParse::Value(*Params, TEXT("ExpectHash="), ExpectedHash) &&
+        FCString::Strtoui64(*ExpectedHash, nullptr, 16) != Stats.ContentHash)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldGeneration: content hash %016llx does not match expected %s"), Stats.ContentHash, *ExpectedHash);
+        Result = 1;
+    }
+
+    float MaxMs = 0.0f;
+    if (FParse::Value(*Params, TEXT("MaxMs="), MaxMs) && BestSeconds * 1000.0 > MaxMs)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldGeneration: best run %.2f ms exceeds budget %.2f ms"), BestSeconds * 1000.0, MaxMs);
+        Result = 1;
+    }
+
+    return Result;
+}
+
+bool UWorldGenerationCommandlet::RunGeneration(ARandomMapGenerator* Generator, double& OutSeconds)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    // Takılan bir build sonsuza kadar beklemesin
+    const double TimeoutSeconds = 600.0;
+
+    Generator->GenerateWorld();
+
+    // Tick: stage'ler, build gönderimi ve tamamlanma; worker build sonuçları game thread task'ı olarak commit edilir
+    while (Generator->IsGeneratingWorld())
+    {
+        Generator->Tick(1.0f / 60.0f);
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+        {
+            return false;
+        }
+    }
+
+    OutSeconds = FPlatformTime::Seconds() - StartTime;
+    return true;
+}
+
+void UWorldGenerationCommandlet::ReportStatistics(ARandomMapGenerator* Generator, int32 RunIndex, double Seconds, bool bPerChunk, TArray<FString>& OutLines)
+{
+    FWorldGenerationStats Stats;
+    Generator->GatherWorldStatistics(Stats);
+
+    auto AddLine = [&OutLines](const FString& Line)
+    {
+        UE_LOG(LogTemp, Display, TEXT("%s"), *Line);
+        OutLines.Add(Line);
+    };
+
+    const FString Prefix = FString::Printf(TEXT("run%d."), RunIndex);
+    AddLine(FString::Printf(TEXT("%stotal_ms=%.2f"), *Prefix, Seconds * 1000.0));
+
+    // Stage süreleri (pipeline sırasıyla)
+    const UEnum* StageEnum = StaticEnum<EWorldGenerationStage>();
+    for (const auto& StagePair : Generator->GetGenerationStageTimes())
+    {
+        AddLine(FString::Printf(TEXT("%sstage.%s_ms=%.2f"), *Prefix,
+            *StageEnum->GetNameStringByValue(static_cast<int64>(StagePair.Key)), StagePair.Value * 1000.0f));
+    }
+
+    AddLine(FString::Printf(TEXT("%schunks=%d"), *Prefix, Stats.NumChunks));
+    AddLine(FString::Printf(TEXT("%sgenerated_chunks=%d"), *Prefix, Stats.NumGeneratedChunks));
+
+    const UEnum* BlockEnum = StaticEnum<EBlockType>();
+    for (int32 TypeIdx = 0; TypeIdx < static_cast<int32>(EBlockType::MAX); TypeIdx++)
+    {
+        AddLine(FString::Printf(TEXT("%sblocks.%s=%lld"), *Prefix, *BlockEnum->GetNameStringByValue(TypeIdx), Stats.BlockCounts[TypeIdx]));
+    }
+
+    AddLine(FString::Printf(TEXT("%sinstances=%lld"), *Prefix, Stats.TotalInstances));
+    AddLine(FString::Printf(TEXT("%smerged_mesh_triangles=%lld"), *Prefix, Stats.MergedMeshTriangles));
+    AddLine(FString::Printf(TEXT("%sblock_data_kb=%llu"), *Prefix, static_cast<uint64>(Stats.BlockDataBytes / 1024)));
+    AddLine(FString::Printf(TEXT("%sused_physical_mb=%llu"), *Prefix, static_cast<uint64>(FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024))));
+    AddLine(FString::Printf(TEXT("%scontent_hash=%016llx"), *Prefix, Stats.ContentHash));
+
+    if (bPerChunk)
+    {
+        for (const auto& ChunkPair : Stats.InstancesPerChunk)
+        {
+            AddLine(FString::Printf(TEXT("chunk.%d_%d.instances=%d"), ChunkPair.Key.X, ChunkPair.Key.Y, ChunkPair.Value));
+        }
+    }
+}
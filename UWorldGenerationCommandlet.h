@@ -0,0 +1,35 @@
+﻿// UWorldGenerationCommandlet.h - Headless world generation for profiling and CI
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UWorldGenerationCommandlet.generated.h"
+
+class ARandomMapGenerator;
+
+/**
+ * Generates a world in a transient game world without a player, network session or renderer and prints
+ * per-stage timings, block counts per EBlockType, instance counts per chunk, memory use and a content hash.
+ *
+ * UnrealEditor-Cmd BaseDefense.uproject -run=WorldGeneration -nullrhi -Seed=1234
+ *     [-Generator=/Game/Blueprints/BP_MapGenerator.BP_MapGenerator_C] [-WorldSize=8] [-ChunkSize=16] [-ChunkHeight=64]
+ *     [-BudgetMs=0] [-Runs=1] [-SyncBuilds] [-PerChunk] [-Report=<file>] [-ExpectHash=<hex>] [-MaxMs=<ms>]
+ *
+ * Returns 1 if the content hash differs from -ExpectHash or the fastest run is slower than -MaxMs (CI gate).
+ */
+UCLASS()
+class BASEDEFENSE_API UWorldGenerationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UWorldGenerationCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    // Runs one full generation and pumps game thread tasks until the chunk builds are committed
+    bool RunGeneration(ARandomMapGenerator* Generator, double& OutSeconds);
+
+    void ReportStatistics(ARandomMapGenerator* Generator, int32 RunIndex, double Seconds, bool bPerChunk, TArray<FString>& OutLines);
+};